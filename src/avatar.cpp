@@ -147,7 +147,22 @@ void avatar::deserialize_map_memory( JsonIn &jsin )
     player_map_memory.load( jsin );
 }
 
-memorized_terrain_tile avatar::get_memorized_tile( const tripoint &pos ) const
+void avatar::set_map_memory_path( const std::string &path )
+{
+    player_map_memory.set_save_path( path );
+}
+
+bool avatar::save_map_memory_regions()
+{
+    return player_map_memory.save_regions();
+}
+
+void avatar::prepare_map_memory_region( const tripoint &p )
+{
+    player_map_memory.prepare_region( p );
+}
+
+const memorized_terrain_tile &avatar::get_memorized_tile( const tripoint &pos ) const
 {
     return player_map_memory.get_tile( pos );
 }
@@ -155,12 +170,12 @@ memorized_terrain_tile avatar::get_memorized_tile( const tripoint &pos ) const
 void avatar::memorize_tile( const tripoint &pos, const std::string &ter, const int subtile,
                             const int rotation )
 {
-    player_map_memory.memorize_tile( max_memorized_tiles(), pos, ter, subtile, rotation );
+    player_map_memory.memorize_tile( max_memorized_submaps(), pos, ter, subtile, rotation );
 }
 
 void avatar::memorize_symbol( const tripoint &pos, const int symbol )
 {
-    player_map_memory.memorize_symbol( max_memorized_tiles(), pos, symbol );
+    player_map_memory.memorize_symbol( max_memorized_submaps(), pos, symbol );
 }
 
 int avatar::get_memorized_symbol( const tripoint &p ) const
@@ -168,7 +183,7 @@ int avatar::get_memorized_symbol( const tripoint &p ) const
     return player_map_memory.get_symbol( p );
 }
 
-size_t avatar::max_memorized_tiles() const
+size_t avatar::max_memorized_submaps() const
 {
     // Only check traits once a turn since this is called a huge number of times.
     if( current_map_memory_turn != calendar::turn ) {
@@ -178,7 +193,7 @@ size_t avatar::max_memorized_tiles() const
         if( has_active_bionic( bio_memory ) ) {
             map_memory_capacity_multiplier = 50;
         }
-        current_map_memory_capacity = 2 * SEEX * 2 * SEEY * 100 * map_memory_capacity_multiplier;
+        current_map_memory_capacity = 2 * 2 * 100 * map_memory_capacity_multiplier;
     }
     return current_map_memory_capacity;
 }
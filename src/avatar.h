@@ -77,6 +77,11 @@ class avatar : public player
         void deserialize( JsonIn &jsin ) override;
         void serialize_map_memory( JsonOut &jsout ) const;
         void deserialize_map_memory( JsonIn &jsin );
+        /** Directory the map memory regions are kept in, see map_memory::set_save_path. */
+        void set_map_memory_path( const std::string &path );
+        bool save_map_memory_regions();
+        /** Unloads the saved map memory regions far from @p p (absolute map square). */
+        void prepare_map_memory_region( const tripoint &p );
 
         // newcharacter.cpp
         bool create( character_type type, const std::string &tempname = "" );
@@ -101,13 +106,13 @@ class avatar : public player
         void memorize_tile( const tripoint &pos, const std::string &ter, int subtile,
                             int rotation );
         /** Returns last stored map tile in given location in tiles mode */
-        memorized_terrain_tile get_memorized_tile( const tripoint &p ) const;
+        const memorized_terrain_tile &get_memorized_tile( const tripoint &p ) const;
         /** Memorizes a given tile in curses mode; finalize_terrain_memory_curses needs to be called after it */
         void memorize_symbol( const tripoint &pos, int symbol );
         /** Returns last stored map tile in given location in curses mode */
         int get_memorized_symbol( const tripoint &p ) const;
-        /** Returns the amount of tiles survivor can remember. */
-        size_t max_memorized_tiles() const;
+        /** Returns the amount of submaps survivor can remember. */
+        size_t max_memorized_submaps() const;
         void clear_memorized_tile( const tripoint &pos );
 
         nc_color basic_symbol_color() const override;
@@ -307,7 +312,7 @@ class avatar : public player
     private:
         map_memory player_map_memory;
         bool show_map_memory;
-        /** Used in max_memorized_tiles to cache memory capacity. **/
+        /** Used in max_memorized_submaps to cache memory capacity. **/
         mutable time_point current_map_memory_turn = calendar::before_time_starts;
         mutable size_t current_map_memory_capacity = 0;
 
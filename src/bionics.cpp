@@ -482,6 +482,7 @@ void npc::discharge_cbm_weapon()
     const bionic &bio = ( *my_bionics )[cbm_weapon_index];
     mod_power_level( -bio.info().power_activate );
     weapon = real_weapon;
+    invalidate_enchantment_cache();
     cbm_weapon_index = -1;
 }
 
@@ -570,6 +571,8 @@ bool Character::activate_bionic( int b, bool eff_only, bool *close_bionics_ui )
         return deactivate_bionic( b );
     }
 
+    invalidate_enchantment_cache();
+
     // eff_only means only do the effect without messing with stats or displaying messages
     if( !eff_only ) {
         if( bio.powered ) {
@@ -1106,6 +1109,7 @@ bool Character::deactivate_bionic( int b, bool eff_only )
     }
 
     bionic &bio = ( *my_bionics )[b];
+    invalidate_enchantment_cache();
 
     if( bio.info().is_remote_fueled ) {
         reset_remote_fuel();
@@ -1674,6 +1678,7 @@ void Character::process_bionic( const int b )
     if( bio.id == bio_remote ) {
         if( g->remoteveh() == nullptr && get_value( "remote_controlling" ).empty() ) {
             bio.powered = false;
+            invalidate_enchantment_cache();
             add_msg_if_player( m_warning, _( "Your %s has lost connection and is turning off." ),
                                bio.info().name );
         }
@@ -2672,6 +2677,8 @@ void Character::add_bionic( const bionic_id &b )
     }
 
     my_bionics->push_back( bionic( b, get_free_invlet( *this ) ) );
+    add_to_flag_index( flag_index, *b, 1 );
+    invalidate_enchantment_cache();
     if( b == bio_tools || b == bio_ears ) {
         activate_bionic( my_bionics->size() - 1 );
     }
@@ -2747,6 +2754,8 @@ void Character::remove_bionic( const bionic_id &b )
     }
 
     *my_bionics = new_my_bionics;
+    rebuild_flag_index();
+    invalidate_enchantment_cache();
     calc_encumbrance();
     recalc_sight_limits();
     if( !b->enchantments.empty() ) {
@@ -2800,6 +2809,8 @@ bionic &Character::bionic_at_index( int i )
 void Character::clear_bionics()
 {
     my_bionics->clear();
+    rebuild_flag_index();
+    invalidate_enchantment_cache();
 }
 
 void reset_bionics()
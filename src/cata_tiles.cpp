@@ -289,6 +289,12 @@ tile_type &tileset::create_tile_type( const std::string &id, tile_type &&new_til
 void cata_tiles::load_tileset( const std::string &tileset_id, const bool precheck,
                                const bool force )
 {
+    // This is also called after the game data is loaded, which reassigns the int ids.
+    for( std::vector<resolved_tile> &by_id : resolved_tiles ) {
+        by_id.clear();
+    }
+    // The recorded sprites point into the old tileset.
+    invalidate_static_layers();
     if( tileset_ptr && tileset_ptr->get_tileset_id() == tileset_id && !force ) {
         return;
     }
@@ -312,6 +318,13 @@ void cata_tiles::reinit()
 {
     set_draw_scale( 16 );
     RenderClear( renderer );
+    invalidate_static_layers();
+}
+
+void cata_tiles::invalidate_static_layers()
+{
+    static_layers_drawn.clear();
+    static_layers_tex.reset();
 }
 
 static void get_tile_information( const std::string &config_path, std::string &json_path,
@@ -1075,6 +1088,14 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
     map &here = get_map();
     const visibility_variables &cache = here.get_visibility_variables_cache();
 
+    const season_type season = season_of_year( calendar::turn );
+    if( season != resolved_season ) {
+        for( std::vector<resolved_tile> &by_id : resolved_tiles ) {
+            by_id.clear();
+        }
+        resolved_season = season;
+    }
+
     const bool iso_mode = tile_iso;
 
     o = iso_mode ? center.xy() : center.xy() - point( POSX, POSY );
@@ -1154,8 +1175,16 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                                            cache ) );
     };
 
+    // The terrain, furniture, graffiti and traps of every row are recorded first (see
+    // static_layers_frame), and the other layers are drawn on top of them afterwards.
+    std::vector<std::vector<tile_render_info>> draw_points_by_row( max_row - min_row );
+    std::vector<size_t> static_row_ends;
+    static_row_ends.reserve( max_row - min_row );
+    static_layers_frame.clear();
+    recorded_sprites_in_tiles = true;
+    sprite_record = &static_layers_frame;
     for( int row = min_row; row < max_row; row ++ ) {
-        std::vector<tile_render_info> draw_points;
+        std::vector<tile_render_info> &draw_points = draw_points_by_row[row - min_row];
         draw_points.reserve( max_col );
         for( int col = min_col; col < max_col; col ++ ) {
             int temp_x;
@@ -1355,8 +1384,35 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
 
             draw_points.emplace_back( pos, height_3d, ll, invisible );
         }
-        const std::array<decltype( &cata_tiles::draw_furniture ), 11> drawing_layers = {{
-                &cata_tiles::draw_furniture, &cata_tiles::draw_graffiti, &cata_tiles::draw_trap,
+        const std::array<decltype( &cata_tiles::draw_furniture ), 3> static_layers = {{
+                &cata_tiles::draw_furniture, &cata_tiles::draw_graffiti, &cata_tiles::draw_trap
+            }
+        };
+        for( auto f : static_layers ) {
+            for( auto &p : draw_points ) {
+                ( this->*f )( p.pos, p.ll, p.height_3d, p.invisible );
+            }
+        }
+        static_row_ends.push_back( static_layers_frame.size() );
+    }
+    sprite_record = nullptr;
+
+    // When no sprite of the static layers sticks out of its tile, none of them overlaps a
+    // sprite of another row, so drawing them all before the other layers gives the same
+    // picture as drawing them row by row.
+    const bool static_layers_cached = !iso_mode && recorded_sprites_in_tiles;
+    if( static_layers_cached ) {
+        draw_static_layers( SDL_Rect{ dest.x, dest.y, width, height } );
+    }
+    for( int row = min_row; row < max_row; row ++ ) {
+        std::vector<tile_render_info> &draw_points = draw_points_by_row[row - min_row];
+        if( !static_layers_cached ) {
+            const size_t row_begin = row == min_row ? 0 : static_row_ends[row - min_row - 1];
+            const size_t row_end = static_row_ends[row - min_row];
+            replay_sprites( static_layers_frame.begin() + row_begin,
+                            static_layers_frame.begin() + row_end, point_zero );
+        }
+        const std::array<decltype( &cata_tiles::draw_furniture ), 8> drawing_layers = {{
                 &cata_tiles::draw_field_or_item, &cata_tiles::draw_vpart_below,
                 &cata_tiles::draw_critter_at_below, &cata_tiles::draw_terrain_below,
                 &cata_tiles::draw_vpart, &cata_tiles::draw_critter_at,
@@ -1714,7 +1770,41 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
         return false;
     }
 
-    cata::optional<tile_lookup_res> res = find_tile_looks_like( id, category );
+    return draw_resolved_tile( id, find_tile_looks_like( id, category ), nullptr, category,
+                               subcategory, pos, subtile, rota, ll, apply_night_vision_goggles,
+                               height_3d );
+}
+
+bool cata_tiles::draw_from_int_id( const int int_id, const std::string &id,
+                                   const TILE_CATEGORY category, const tripoint &pos,
+                                   const int subtile, const int rota, const lit_level ll,
+                                   const bool apply_night_vision_goggles, int &height_3d )
+{
+    half_open_rectangle<point> screen_bounds( o, o + point( screentile_width, screentile_height ) );
+    if( !tile_iso &&
+        !screen_bounds.contains( pos.xy() ) ) {
+        return false;
+    }
+
+    std::vector<resolved_tile> &by_id = resolved_tiles[category];
+    if( static_cast<size_t>( int_id ) >= by_id.size() ) {
+        by_id.resize( int_id + 1 );
+    }
+    resolved_tile &resolved = by_id[int_id];
+    if( !resolved.resolved ) {
+        resolved.res = find_tile_looks_like( id, category );
+        resolved.resolved = true;
+    }
+    return draw_resolved_tile( id, resolved.res, &resolved, category, empty_string, pos, subtile,
+                               rota, ll, apply_night_vision_goggles, height_3d );
+}
+
+bool cata_tiles::draw_resolved_tile( const std::string &id, cata::optional<tile_lookup_res> res,
+                                     resolved_tile *resolved, TILE_CATEGORY category,
+                                     const std::string &subcategory, const tripoint &pos,
+                                     int subtile, int rota, lit_level ll,
+                                     bool apply_night_vision_goggles, int &height_3d )
+{
     const tile_type *tt = nullptr;
     if( res ) {
         tt = &( res -> tile() );
@@ -1891,6 +1981,26 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
     const tile_type &display_tile = *tt;
     // check to see if the display_tile is multitile, and if so if it has the key related to
     // subtile
+    if( subtile != -1 && display_tile.multitile && resolved != nullptr && res ) {
+        if( resolved->subtiles.empty() ) {
+            resolved->subtiles.resize( multitile_keys.size() );
+        }
+        resolved_subtile &sub = resolved->subtiles[subtile];
+        if( !sub.resolved ) {
+            const auto &display_subtiles = display_tile.available_subtiles;
+            const auto end = std::end( display_subtiles );
+            sub.has_variant = std::find( begin( display_subtiles ), end,
+                                         multitile_keys[subtile] ) != end;
+            if( sub.has_variant ) {
+                sub.res = find_tile_looks_like( found_id + "_" + multitile_keys[subtile], category );
+            }
+            sub.resolved = true;
+        }
+        if( sub.has_variant && sub.res ) {
+            return draw_resolved_tile( sub.res->id(), sub.res, nullptr, category, subcategory, pos,
+                                       -1, rota, ll, apply_night_vision_goggles, height_3d );
+        }
+    }
     if( subtile != -1 && display_tile.multitile ) {
         const auto &display_subtiles = display_tile.available_subtiles;
         const auto end = std::end( display_subtiles );
@@ -2129,8 +2239,7 @@ bool cata_tiles::draw_sprite_at(
             default:
             case 0:
                 // unrotated (and 180, with just two sprites)
-                ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                  SDL_FLIP_NONE );
+                ret = copy_sprite( *sprite_tex, p, destination, 0, SDL_FLIP_NONE );
                 break;
             case 1:
                 // 90 degrees (and 270, with just two sprites)
@@ -2143,22 +2252,19 @@ bool cata_tiles::draw_sprite_at(
 #endif
                 if( !tile_iso ) {
                     // never rotate isometric tiles
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, -90, nullptr,
-                                                      SDL_FLIP_NONE );
+                    ret = copy_sprite( *sprite_tex, p, destination, -90, SDL_FLIP_NONE );
                 } else {
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                      SDL_FLIP_NONE );
+                    ret = copy_sprite( *sprite_tex, p, destination, 0, SDL_FLIP_NONE );
                 }
                 break;
             case 2:
                 // 180 degrees, implemented with flips instead of rotation
                 if( !tile_iso ) {
                     // never flip isometric tiles vertically
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                      static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL ) );
+                    ret = copy_sprite( *sprite_tex, p, destination, 0,
+                                       static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL ) );
                 } else {
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                      SDL_FLIP_NONE );
+                    ret = copy_sprite( *sprite_tex, p, destination, 0, SDL_FLIP_NONE );
                 }
                 break;
             case 3:
@@ -2172,21 +2278,19 @@ bool cata_tiles::draw_sprite_at(
 #endif
                 if( !tile_iso ) {
                     // never rotate isometric tiles
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, 90, nullptr,
-                                                      SDL_FLIP_NONE );
+                    ret = copy_sprite( *sprite_tex, p, destination, 90, SDL_FLIP_NONE );
                 } else {
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                      SDL_FLIP_NONE );
+                    ret = copy_sprite( *sprite_tex, p, destination, 0, SDL_FLIP_NONE );
                 }
                 break;
             case 4:
                 // flip horizontally
-                ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                  static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL ) );
+                ret = copy_sprite( *sprite_tex, p, destination, 0,
+                                   static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL ) );
         }
     } else {
         // don't rotate, same as case 0 above
-        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr, SDL_FLIP_NONE );
+        ret = copy_sprite( *sprite_tex, p, destination, 0, SDL_FLIP_NONE );
     }
 
     printErrorIf( ret != 0, "SDL_RenderCopyEx() failed" );
@@ -2197,6 +2301,69 @@ bool cata_tiles::draw_sprite_at(
     return true;
 }
 
+bool cata_tiles::sprite_copy::operator==( const sprite_copy &rhs ) const
+{
+    return tex == rhs.tex && dest.x == rhs.dest.x && dest.y == rhs.dest.y &&
+           dest.w == rhs.dest.w && dest.h == rhs.dest.h && angle == rhs.angle && flip == rhs.flip;
+}
+
+int cata_tiles::copy_sprite( const texture &tex, const point &tile_pos, const SDL_Rect &dest,
+                             const int angle, const SDL_RendererFlip flip )
+{
+    if( sprite_record == nullptr ) {
+        return tex.render_copy_ex( renderer, &dest, angle, nullptr, flip );
+    }
+    sprite_record->push_back( { &tex, dest, angle, flip } );
+    // a rotated sprite only keeps its place if it is square
+    if( dest.x < tile_pos.x || dest.y < tile_pos.y ||
+        dest.x + dest.w > tile_pos.x + tile_width || dest.y + dest.h > tile_pos.y + tile_height ||
+        ( angle != 0 && dest.w != dest.h ) ) {
+        recorded_sprites_in_tiles = false;
+    }
+    return 0;
+}
+
+void cata_tiles::replay_sprites( const std::vector<sprite_copy>::const_iterator begin,
+                                 const std::vector<sprite_copy>::const_iterator end,
+                                 const point &origin )
+{
+    for( auto it = begin; it != end; ++it ) {
+        SDL_Rect dest = it->dest;
+        dest.x -= origin.x;
+        dest.y -= origin.y;
+        printErrorIf( it->tex->render_copy_ex( renderer, &dest, it->angle, nullptr, it->flip ) != 0,
+                      "SDL_RenderCopyEx() failed" );
+    }
+}
+
+void cata_tiles::draw_static_layers( const SDL_Rect &view )
+{
+    const bool same_view = static_layers_tex && view.x == static_layers_view.x &&
+                           view.y == static_layers_view.y && view.w == static_layers_view.w &&
+                           view.h == static_layers_view.h;
+    if( !same_view || static_layers_frame != static_layers_drawn ) {
+        if( !static_layers_tex || view.w != static_layers_view.w ||
+            view.h != static_layers_view.h ) {
+            static_layers_tex = CreateTexture( renderer, SDL_PIXELFORMAT_ARGB8888,
+                                               SDL_TEXTUREACCESS_TARGET, view.w, view.h );
+        }
+        static_layers_view = view;
+        SetRenderTarget( renderer, static_layers_tex );
+        SetRenderDrawColor( renderer, 0x00, 0x00, 0x00, 0xFF );
+        RenderClear( renderer );
+        replay_sprites( static_layers_frame.begin(), static_layers_frame.end(),
+                        point( view.x, view.y ) );
+        set_displaybuffer_rendertarget();
+        // the render target change reset the clipping set up by draw()
+        printErrorIf( SDL_RenderSetClipRect( renderer.get(), &view ) != 0,
+                      "SDL_RenderSetClipRect failed" );
+        static_layers_drawn.swap( static_layers_frame );
+    }
+    // the texture replaces the black the view was cleared to
+    SetTextureBlendMode( static_layers_tex, SDL_BLENDMODE_NONE );
+    RenderCopy( renderer, static_layers_tex, nullptr, &view );
+}
+
 bool cata_tiles::draw_tile_at(
     const tile_type &tile, const point &p, unsigned int loc_rand, int rota,
     lit_level ll, bool apply_night_vision_goggles, int &height_3d )
@@ -2353,8 +2520,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
         }
         // draw the actual terrain if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d );
+            return draw_from_int_id( t.to_i(), tname, C_TERRAIN, p, subtile, rotation, ll,
+                                     nv_goggles_activated, height_3d );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -2376,8 +2543,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation,
-                                        lit, nv, height_3d );
+            return draw_from_int_id( t2.to_i(), tname, C_TERRAIN, p, subtile, rotation, lit, nv,
+                                     height_3d );
         }
     } else if( invisible[0] && has_terrain_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
@@ -2392,7 +2559,7 @@ bool cata_tiles::has_memory_at( const tripoint &p ) const
 {
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
-        const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = you.get_memorized_tile( get_map().getabs( p ) );
         return !t.tile.empty();
     }
     return false;
@@ -2402,7 +2569,7 @@ bool cata_tiles::has_terrain_memory_at( const tripoint &p ) const
 {
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
-        const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = you.get_memorized_tile( get_map().getabs( p ) );
         if( string_starts_with( t.tile, "t_" ) ) {
             return true;
         }
@@ -2414,7 +2581,7 @@ bool cata_tiles::has_furniture_memory_at( const tripoint &p ) const
 {
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
-        const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = you.get_memorized_tile( get_map().getabs( p ) );
         if( string_starts_with( t.tile, "f_" ) ) {
             return true;
         }
@@ -2426,7 +2593,7 @@ bool cata_tiles::has_trap_memory_at( const tripoint &p ) const
 {
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
-        const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = you.get_memorized_tile( get_map().getabs( p ) );
         if( string_starts_with( t.tile, "tr_" ) ) {
             return true;
         }
@@ -2438,7 +2605,7 @@ bool cata_tiles::has_vpart_memory_at( const tripoint &p ) const
 {
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
-        const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = you.get_memorized_tile( get_map().getabs( p ) );
         if( string_starts_with( t.tile, "vp_" ) ) {
             return true;
         }
@@ -2450,7 +2617,7 @@ memorized_terrain_tile cata_tiles::get_terrain_memory_at( const tripoint &p ) co
 {
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
-        const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = you.get_memorized_tile( get_map().getabs( p ) );
         if( string_starts_with( t.tile, "t_" ) ) {
             return t;
         }
@@ -2462,7 +2629,7 @@ memorized_terrain_tile cata_tiles::get_furniture_memory_at( const tripoint &p )
 {
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
-        const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = you.get_memorized_tile( get_map().getabs( p ) );
         if( string_starts_with( t.tile, "f_" ) ) {
             return t;
         }
@@ -2474,7 +2641,7 @@ memorized_terrain_tile cata_tiles::get_trap_memory_at( const tripoint &p ) const
 {
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
-        const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = you.get_memorized_tile( get_map().getabs( p ) );
         if( string_starts_with( t.tile, "tr_" ) ) {
             return t;
         }
@@ -2486,7 +2653,7 @@ memorized_terrain_tile cata_tiles::get_vpart_memory_at( const tripoint &p ) cons
 {
     avatar &you = get_avatar();
     if( you.should_show_map_memory() ) {
-        const memorized_terrain_tile t = you.get_memorized_tile( get_map().getabs( p ) );
+        const memorized_terrain_tile &t = you.get_memorized_tile( get_map().getabs( p ) );
         if( string_starts_with( t.tile, "vp_" ) ) {
             return t;
         }
@@ -2535,8 +2702,8 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
         }
         // draw the actual furniture if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d );
+            return draw_from_int_id( f.to_i(), fname, C_FURNITURE, p, subtile, rotation, ll,
+                                     nv_goggles_activated, height_3d );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -2570,8 +2737,8 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation,
-                                        lit, nv, height_3d );
+            return draw_from_int_id( f2.to_i(), fname, C_FURNITURE, p, subtile, rotation, lit, nv,
+                                     height_3d );
         }
     } else if( invisible[0] && has_furniture_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
@@ -2617,8 +2784,8 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
         }
         // draw the actual trap if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( trname, C_TRAP, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d );
+            return draw_from_int_id( tr.loadid.to_i(), trname, C_TRAP, p, subtile, rotation, ll,
+                                     nv_goggles_activated, height_3d );
         }
     }
     if( overridden || ( !invisible[0] && neighborhood_overridden &&
@@ -2647,8 +2814,8 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( trname, C_TRAP, empty_string, p, subtile, rotation,
-                                        lit, nv, height_3d );
+            return draw_from_int_id( tr2.to_i(), trname, C_TRAP, p, subtile, rotation, lit, nv,
+                                     height_3d );
         }
     } else if( invisible[0] && has_trap_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
@@ -2702,8 +2869,9 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
         int rotation = 0;
         get_tile_values( fld.to_i(), neighborhood, subtile, rotation );
 
-        ret_draw_field = draw_from_id_string( fld.id().str(), C_FIELD, empty_string, p, subtile,
-                                              rotation, lit, nv );
+        int nullint = 0;
+        ret_draw_field = draw_from_int_id( fld.to_i(), fld.id().str(), C_FIELD, p, subtile,
+                                           rotation, lit, nv, nullint );
     }
     if( fld.obj().display_items ) {
         const auto it_override = item_override.find( p );
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_CATA_TILES_H
 #define CATA_SRC_CATA_TILES_H
 
+#include <array>
 #include <cstddef>
 #include <map>
 #include <memory>
@@ -12,6 +13,7 @@
 #include <vector>
 
 #include "animation.h"
+#include "calendar.h"
 #include "creature.h"
 #include "enums.h"
 #include "lightmap.h"
@@ -354,6 +356,14 @@ class cata_tiles
         bool draw_from_id_string( const std::string &id, TILE_CATEGORY category,
                                   const std::string &subcategory, const tripoint &pos, int subtile, int rota,
                                   lit_level ll, bool apply_night_vision_goggles, int &height_3d );
+        /**
+         * As draw_from_id_string, for the types with int ids (terrain, furniture, traps and
+         * fields): @p id and its subtiles are only looked up the first time @p int_id of
+         * @p category is drawn with the current tileset and season.
+         */
+        bool draw_from_int_id( int int_id, const std::string &id, TILE_CATEGORY category,
+                               const tripoint &pos, int subtile, int rota, lit_level ll,
+                               bool apply_night_vision_goggles, int &height_3d );
         bool draw_sprite_at(
             const tile_type &tile, const weighted_int_list<std::vector<int>> &svlist,
             const point &, unsigned int loc_rand, bool rota_fg, int rota, lit_level ll,
@@ -518,6 +528,8 @@ class cata_tiles
          * @throw std::exception On any error.
          */
         void reinit();
+        /** Drops the cached static map layers, e.g. when the render targets were lost. */
+        void invalidate_static_layers();
 
         int get_tile_height() const {
             return tile_height;
@@ -636,6 +648,73 @@ class cata_tiles
 
         pimpl<pixel_minimap> minimap;
 
+        struct resolved_subtile {
+            bool resolved = false;
+            /** Whether the tile has a variant for the subtile. */
+            bool has_variant = false;
+            cata::optional<tile_lookup_res> res;
+        };
+        /** The result of find_tile_looks_like for a type, see draw_from_int_id. */
+        struct resolved_tile {
+            bool resolved = false;
+            cata::optional<tile_lookup_res> res;
+            /** Indexed by subtile, only filled in for multitiles. */
+            std::vector<resolved_subtile> subtiles;
+        };
+
+        /** Draws the tile @p id was resolved to, see draw_from_id_string. */
+        bool draw_resolved_tile( const std::string &id, cata::optional<tile_lookup_res> res,
+                                 resolved_tile *resolved, TILE_CATEGORY category,
+                                 const std::string &subcategory, const tripoint &pos, int subtile,
+                                 int rota, lit_level ll, bool apply_night_vision_goggles,
+                                 int &height_3d );
+
+        /**
+         * Resolved tiles by category and int id.  Cleared when the tileset or the game data is
+         * loaded, as either changes what the ids resolve to, and when the season changes.
+         */
+        std::array<std::vector<resolved_tile>, C_WEATHER + 1> resolved_tiles;
+        season_type resolved_season = NUM_SEASONS;
+
+        /** A sprite copied to the screen, as recorded by draw_sprite_at. */
+        struct sprite_copy {
+            const texture *tex;
+            SDL_Rect dest;
+            int angle;
+            SDL_RendererFlip flip;
+
+            bool operator==( const sprite_copy &rhs ) const;
+        };
+
+        /**
+         * Copies @p tex to @p dest, or records the copy if a recording is active.
+         * @param tile_pos The screen position of the tile the sprite is drawn for.
+         */
+        int copy_sprite( const texture &tex, const point &tile_pos, const SDL_Rect &dest, int angle,
+                         SDL_RendererFlip flip );
+        /** Copies recorded sprites to the screen, offset by -@p origin. */
+        void replay_sprites( std::vector<sprite_copy>::const_iterator begin,
+                             std::vector<sprite_copy>::const_iterator end, const point &origin );
+        /**
+         * Copies the sprites of the static layers recorded this frame to the screen through
+         * static_layers_tex, which is only redrawn if they differ from the previous frame.
+         */
+        void draw_static_layers( const SDL_Rect &view );
+
+        /** Where copy_sprite records sprites instead of drawing them, unless null. */
+        std::vector<sprite_copy> *sprite_record = nullptr;
+        /** Whether every recorded sprite lies within its own tile. */
+        bool recorded_sprites_in_tiles = true;
+        /**
+         * The terrain, furniture, graffiti and trap sprites of the current frame, see draw().
+         * Those rarely change from a frame to the next, unlike the creatures and items on top.
+         */
+        std::vector<sprite_copy> static_layers_frame;
+        /** The sprites static_layers_tex was drawn from. */
+        std::vector<sprite_copy> static_layers_drawn;
+        SDL_Texture_Ptr static_layers_tex;
+        SDL_Rect static_layers_view = { 0, 0, 0, 0 };
+
     public:
         std::string memory_map_mode = "color_pixel_sepia";
 };
@@ -51,6 +51,7 @@
 #include "item_contents.h"
 #include "item_location.h"
 #include "item_pocket.h"
+#include "item_size_cache.h"
 #include "item_stack.h"
 #include "itype.h"
 #include "iuse.h"
@@ -84,6 +85,7 @@
 #include "pathfinding.h"
 #include "player.h"
 #include "proficiency.h"
+#include "profiler.h"
 #include "recipe_dictionary.h"
 #include "ret_val.h"
 #include "rng.h"
@@ -2822,6 +2824,8 @@ units::volume Character::max_single_item_volume() const
 
 std::pair<item_location, item_pocket *> Character::best_pocket( const item &it, const item *avoid )
 {
+    // compares the fill level of the same containers many times
+    const item_size_cache::scope size_cache;
     item_location weapon_loc( *this, &weapon );
     std::pair<item_location, item_pocket *> ret = std::make_pair( item_location(), nullptr );
     if( &weapon != &it && &weapon != avoid ) {
@@ -3296,6 +3300,7 @@ item Character::remove_weapon()
 {
     item tmp = weapon;
     weapon = item();
+    invalidate_enchantment_cache();
     get_event_bus().send<event_type::character_wields_item>( getID(), weapon.typeId() );
     cached_info.erase( "weapon_value" );
     return tmp;
@@ -3535,6 +3540,7 @@ units::mass Character::weight_carried_with_tweaks( const std::vector<std::pair<i
 
 units::mass Character::weight_carried_with_tweaks( const item_tweaks &tweaks ) const
 {
+    const item_size_cache::scope size_cache;
     const std::map<const item *, int> empty;
     const std::map<const item *, int> &without = tweaks.without_items ? tweaks.without_items->get() :
             empty;
@@ -3605,6 +3611,7 @@ units::volume Character::volume_carried_with_tweaks( const
 
 units::volume Character::volume_carried_with_tweaks( const item_tweaks &tweaks ) const
 {
+    const item_size_cache::scope size_cache;
     const std::map<const item *, int> empty;
     const std::map<const item *, int> &without = tweaks.without_items ? tweaks.without_items->get() :
             empty;
@@ -3929,6 +3936,8 @@ ret_val<bool> Character::can_drop( const item &it ) const
 void Character::invalidate_inventory_validity_cache()
 {
     cache_inventory_is_valid = false;
+    // whatever changed the inventory may have brought or taken enchantments
+    invalidate_enchantment_cache();
 }
 
 void Character::drop_invalid_inventory()
@@ -4383,6 +4392,7 @@ void Character::calc_encumbrance()
 
 void Character::calc_encumbrance( const item &new_item )
 {
+    const item_size_cache::scope size_cache;
 
     std::map<bodypart_id, encumbrance_data> enc;
     item_encumb( enc, new_item );
@@ -4396,6 +4406,7 @@ void Character::calc_encumbrance( const item &new_item )
 
 units::mass Character::get_weight() const
 {
+    const item_size_cache::scope size_cache;
     units::mass ret = 0_gram;
     units::mass wornWeight = std::accumulate( worn.begin(), worn.end(), 0_gram,
     []( units::mass sum, const item & itm ) {
@@ -5509,11 +5520,15 @@ void Character::update_body()
 
 void Character::update_body( const time_point &from, const time_point &to )
 {
+    CATA_PROFILE_ZONE( "Character::update_body" );
     if( !is_npc() ) {
         update_stamina( to_turns<int>( to - from ) );
     }
     update_stomach( from, to );
-    recalculate_enchantment_cache();
+    update_enchantment_cache();
+    if( debug_mode && calendar::once_every( 1_hours ) ) {
+        check_flag_index();
+    }
     if( ticks_between( from, to, 3_minutes ) > 0 ) {
         magic->update_mana( *this->as_player(), to_turns<float>( 3_minutes ) );
     }
@@ -8806,6 +8821,8 @@ bool Character::invoke_item( item *used, const std::string &method, const tripoi
     }
 
     int charges_used = actually_used->type->invoke( *this->as_player(), *actually_used, pt, method );
+    // Using an item may toggle it or turn it into another one, with other enchantments
+    invalidate_enchantment_cache();
     if( charges_used == 0 ) {
         return false;
     }
@@ -9448,13 +9465,21 @@ mutation_category_id Character::get_highest_category() const
 
 void Character::recalculate_enchantment_cache()
 {
-    // start by resetting the cache to all inventory items
-    *enchantment_cache = inv->get_active_enchantment_cache( *this );
+    enchantment_cache_dirty = false;
+    *enchantment_cache_base = enchantment();
+    location_enchantments->clear();
+    const auto add_enchantment = [this]( const enchantment & ench, bool active ) {
+        if( ench.depends_on_location() ) {
+            location_enchantments->push_back( ench );
+        } else if( ench.is_active( *this, active ) ) {
+            enchantment_cache_base->force_add( ench );
+        }
+    };
 
     visit_items( [&]( const item * it, item * ) {
         for( const enchantment &ench : it->get_enchantments() ) {
-            if( ench.is_active( *this, *it ) ) {
-                enchantment_cache->force_add( ench );
+            if( ench.is_carried_right( *this, *it ) ) {
+                add_enchantment( ench, it->active );
             }
         }
         return VisitResponse::NEXT;
@@ -9465,10 +9490,7 @@ void Character::recalculate_enchantment_cache()
         const mutation_branch &mut = mut_map.first.obj();
 
         for( const enchantment_id &ench_id : mut.enchantments ) {
-            const enchantment &ench = ench_id.obj();
-            if( ench.is_active( *this, mut.activated && mut_map.second.powered ) ) {
-                enchantment_cache->force_add( ench );
-            }
+            add_enchantment( ench_id.obj(), mut.activated && mut_map.second.powered );
         }
     }
 
@@ -9476,15 +9498,51 @@ void Character::recalculate_enchantment_cache()
         const bionic_id &bid = bio.id;
 
         for( const enchantment_id &ench_id : bid->enchantments ) {
-            const enchantment &ench = ench_id.obj();
-            if( ench.is_active( *this, bio.powered &&
-                                bid->has_flag( STATIC( json_character_flag( "BIONIC_TOGGLED" ) ) ) ) ) {
-                enchantment_cache->force_add( ench );
-            }
+            add_enchantment( ench_id.obj(), bio.powered &&
+                             bid->has_flag( STATIC( json_character_flag( "BIONIC_TOGGLED" ) ) ) );
+        }
+    }
+
+    *enchantment_cache = *enchantment_cache_base;
+    enchantment_cache_underground = pos().z < 0;
+    enchantment_cache_underwater = !location_enchantments->empty() &&
+                                   get_map().is_divable( pos() );
+    for( const enchantment &ench : *location_enchantments ) {
+        if( ench.is_active( *this, false ) ) {
+            enchantment_cache->force_add( ench );
+        }
+    }
+}
+
+void Character::update_enchantment_cache()
+{
+    if( enchantment_cache_dirty ) {
+        recalculate_enchantment_cache();
+        return;
+    }
+    if( location_enchantments->empty() ) {
+        return;
+    }
+    const bool underground = pos().z < 0;
+    const bool underwater = get_map().is_divable( pos() );
+    if( underground == enchantment_cache_underground && underwater == enchantment_cache_underwater ) {
+        return;
+    }
+    enchantment_cache_underground = underground;
+    enchantment_cache_underwater = underwater;
+    *enchantment_cache = *enchantment_cache_base;
+    for( const enchantment &ench : *location_enchantments ) {
+        if( ench.is_active( *this, false ) ) {
+            enchantment_cache->force_add( ench );
         }
     }
 }
 
+void Character::invalidate_enchantment_cache()
+{
+    enchantment_cache_dirty = true;
+}
+
 double Character::calculate_by_enchantment( double modify, enchant_vals::mod value,
         bool round_output ) const
 {
@@ -13185,10 +13243,17 @@ int Character::book_fun_for( const item &book, const Character &p ) const
 
 bool Character::has_bionic_with_flag( const json_character_flag &flag ) const
 {
+    const auto iter = flag_index.find( flag );
+    if( iter == flag_index.end() ) {
+        return false;
+    }
+    if( iter->second.bionics > 0 ) {
+        return true;
+    }
+    if( iter->second.toggled_bionics == 0 ) {
+        return false;
+    }
     for( const bionic &bio : *my_bionics ) {
-        if( bio.info().has_flag( flag ) ) {
-            return true;
-        }
         if( bio.info().activated ) {
             if( ( bio.info().has_active_flag( flag ) && has_active_bionic( bio.id ) ) ||
                 ( bio.info().has_inactive_flag( flag ) && !has_active_bionic( bio.id ) ) ) {
@@ -13202,6 +13267,80 @@ bool Character::has_bionic_with_flag( const json_character_flag &flag ) const
 
 bool Character::has_flag( const json_character_flag &flag ) const
 {
-    // If this is a performance problem create a map of flags stored for a character and updated on trait, mutation, bionic add/remove, activate/deactivate
     return has_trait_flag( flag ) || has_bionic_with_flag( flag );
 }
+
+bool Character::flag_sources::operator==( const flag_sources &rhs ) const
+{
+    return traits == rhs.traits && toggled_traits == rhs.toggled_traits &&
+           bionics == rhs.bionics && toggled_bionics == rhs.toggled_bionics;
+}
+
+void Character::add_to_flag_index( flag_index_map &index, const mutation_branch &mut,
+                                   int delta )
+{
+    for( const json_character_flag &flag : mut.flags ) {
+        index[flag].traits += delta;
+    }
+    if( mut.activated ) {
+        for( const json_character_flag &flag : mut.active_flags ) {
+            index[flag].toggled_traits += delta;
+        }
+        for( const json_character_flag &flag : mut.inactive_flags ) {
+            index[flag].toggled_traits += delta;
+        }
+    }
+}
+
+void Character::add_to_flag_index( flag_index_map &index, const bionic_data &bio, int delta )
+{
+    for( const json_character_flag &flag : bio.flags ) {
+        index[flag].bionics += delta;
+    }
+    if( bio.activated ) {
+        for( const json_character_flag &flag : bio.active_flags ) {
+            index[flag].toggled_bionics += delta;
+        }
+        for( const json_character_flag &flag : bio.inactive_flags ) {
+            index[flag].toggled_bionics += delta;
+        }
+    }
+}
+
+Character::flag_index_map Character::build_flag_index() const
+{
+    flag_index_map index;
+    for( const std::pair<const trait_id, trait_data> &mut : my_mutations ) {
+        add_to_flag_index( index, mut.first.obj(), 1 );
+    }
+    for( const bionic &bio : *my_bionics ) {
+        add_to_flag_index( index, bio.info(), 1 );
+    }
+    return index;
+}
+
+void Character::rebuild_flag_index()
+{
+    flag_index = build_flag_index();
+}
+
+bool Character::check_flag_index() const
+{
+    const flag_index_map expected = build_flag_index();
+    bool consistent = true;
+    // flags nobody provides anymore linger in the index with all counts at zero
+    for( const std::pair<const json_character_flag, flag_sources> &entry : flag_index ) {
+        const auto iter = expected.find( entry.first );
+        if( !( entry.second == ( iter == expected.end() ? flag_sources() : iter->second ) ) ) {
+            debugmsg( "%s: flag index for %s is out of date", get_name(), entry.first.str() );
+            consistent = false;
+        }
+    }
+    for( const std::pair<const json_character_flag, flag_sources> &entry : expected ) {
+        if( flag_index.find( entry.first ) == flag_index.end() ) {
+            debugmsg( "%s: flag %s is missing from the flag index", get_name(), entry.first.str() );
+            consistent = false;
+        }
+    }
+    return consistent;
+}
@@ -80,6 +80,7 @@ class recipe_subset;
 class spell;
 class vpart_reference;
 struct bionic;
+struct bionic_data;
 struct construction;
 struct dealt_projectile_attack;
 struct display_proficiency;
@@ -979,6 +980,10 @@ class Character : public Creature, public visitable
         using Creature::has_flag;
         /** Returns true if player has a trait or bionic with a flag */
         bool has_flag( const json_character_flag &flag ) const;
+        /** Rebuilds @ref flag_index from scratch, needed after replacing all traits or bionics. */
+        void rebuild_flag_index();
+        /** Reports (through debugmsg) any difference between @ref flag_index and a fresh one. */
+        bool check_flag_index() const;
         /** Returns the trait id with the given invlet, or an empty string if no trait has that invlet */
         trait_id trait_by_invlet( int ch ) const;
 
@@ -1150,6 +1155,14 @@ class Character : public Creature, public visitable
 
         // recalculates enchantment cache by iterating through all held, worn, and wielded items
         void recalculate_enchantment_cache();
+        /**
+         * Brings the enchantment cache up to date, called every turn.  Only recalculates it
+         * if it was invalidated, otherwise just re-checks the enchantments that depend on
+         * where we are.
+         */
+        void update_enchantment_cache();
+        // Something providing enchantments (items, mutations, bionics) may have changed.
+        void invalidate_enchantment_cache();
         // gets add and mult value from enchantment cache
         double calculate_by_enchantment( double modify, enchant_vals::mod value,
                                          bool round_output = false ) const;
@@ -2821,6 +2834,25 @@ class Character : public Creature, public visitable
          * Pointers to mutation branches in @ref my_mutations.
          */
         std::vector<const mutation_branch *> cached_mutations;
+        /** How many of the character's traits and bionics provide a flag. */
+        struct flag_sources {
+            int traits = 0;
+            // traits providing it only while (in)active, those need a closer look
+            int toggled_traits = 0;
+            int bionics = 0;
+            int toggled_bionics = 0;
+
+            bool operator==( const flag_sources &rhs ) const;
+        };
+        using flag_index_map = std::unordered_map<json_character_flag, flag_sources>;
+        /**
+         * Index of the flags provided by traits and bionics, answers @ref has_flag without
+         * iterating over every trait and bionic.  Updated whenever they are added or removed.
+         */
+        flag_index_map flag_index;
+        static void add_to_flag_index( flag_index_map &index, const mutation_branch &mut, int delta );
+        static void add_to_flag_index( flag_index_map &index, const bionic_data &bio, int delta );
+        flag_index_map build_flag_index() const;
         /**
          * The amount of weight the Character is carrying.
          * If it is nullopt, needs to be recalculated
@@ -2915,8 +2947,16 @@ class Character : public Creature, public visitable
         void burn_fuel( int b, const auto_toggle_bionic_result &result );
 
         // a cache of all active enchantment values.
-        // is recalculated every turn in Character::recalculate_enchantment_cache
+        // kept up to date every turn by Character::update_enchantment_cache
         pimpl<enchantment> enchantment_cache;
+        // the part of enchantment_cache that does not depend on where the character is
+        pimpl<enchantment> enchantment_cache_base;
+        // enchantments that apply underground or underwater, re-checked on top of
+        // enchantment_cache_base whenever the character enters or leaves such places
+        pimpl<std::vector<enchantment>> location_enchantments;
+        bool enchantment_cache_dirty = true;
+        bool enchantment_cache_underground = false;
+        bool enchantment_cache_underwater = false;
         player_activity destination_activity;
         /// A unique ID number, assigned by the game class. Values should never be reused.
         character_id id;
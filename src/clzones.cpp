@@ -584,15 +584,9 @@ void zone_manager::cache_data()
         if( !elem.get_enabled() ) {
             continue;
         }
-
-        const std::string &type_hash = elem.get_type_hash();
-        auto &cache = area_cache[type_hash];
-
-        // Draw marked area
-        for( const tripoint &p : tripoint_range<tripoint>( elem.get_start_point(),
-                elem.get_end_point() ) ) {
-            cache.insert( p );
-        }
+        area_cache[elem.get_type_hash()].push_back( { elem.get_start_point(),
+                                                     elem.get_end_point()
+                                                   } );
     }
 }
 
@@ -605,29 +599,33 @@ void zone_manager::cache_vzones()
         if( !elem->get_enabled() ) {
             continue;
         }
-
-        const std::string &type_hash = elem->get_type_hash();
-        auto &cache = vzone_cache[type_hash];
-
-        // TODO: looks very similar to the above cache_data - maybe merge it?
-
-        // Draw marked area
-        for( const tripoint &p : tripoint_range<tripoint>( elem->get_start_point(),
-                elem->get_end_point() ) ) {
-            cache.insert( p );
-        }
+        vzone_cache[elem->get_type_hash()].push_back( { elem->get_start_point(),
+                                                       elem->get_end_point()
+                                                     } );
     }
 }
 
-std::unordered_set<tripoint> zone_manager::get_point_set( const zone_type_id &type,
+std::vector<zone_manager::zone_box> zone_manager::get_boxes( const zone_type_id &type,
         const faction_id &fac ) const
 {
-    const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
-    if( type_iter == area_cache.end() ) {
-        return std::unordered_set<tripoint>();
+    std::vector<zone_box> ret;
+    const std::string type_hash = zone_data::make_type_hash( type, fac );
+    const auto area_iter = area_cache.find( type_hash );
+    if( area_iter != area_cache.end() ) {
+        ret = area_iter->second;
+    }
+    const auto vzone_iter = vzone_cache.find( type_hash );
+    if( vzone_iter != vzone_cache.end() ) {
+        ret.insert( ret.end(), vzone_iter->second.begin(), vzone_iter->second.end() );
     }
+    return ret;
+}
 
-    return type_iter->second;
+// The point of the box closest to p, by square_dist.
+static tripoint closest_point( const tripoint &start, const tripoint &end, const tripoint &p )
+{
+    return tripoint( clamp( p.x, start.x, end.x ), clamp( p.y, start.y, end.y ),
+                     clamp( p.z, start.z, end.z ) );
 }
 
 std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint &where,
@@ -655,47 +653,28 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint &w
     return res;
 }
 
-std::unordered_set<tripoint> zone_manager::get_vzone_set( const zone_type_id &type,
-        const faction_id &fac ) const
-{
-    //Only regenerate the vehicle zone cache if any vehicles have moved
-    const auto &type_iter = vzone_cache.find( zone_data::make_type_hash( type, fac ) );
-    if( type_iter == vzone_cache.end() ) {
-        return std::unordered_set<tripoint>();
-    }
-
-    return type_iter->second;
-}
-
 bool zone_manager::has( const zone_type_id &type, const tripoint &where,
                         const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    const auto &vzone_set = get_vzone_set( type, fac );
-    return point_set.find( where ) != point_set.end() || vzone_set.find( where ) != vzone_set.end();
+    for( const zone_box &box : get_boxes( type, fac ) ) {
+        if( closest_point( box.start, box.end, where ) == where ) {
+            return true;
+        }
+    }
+    return false;
 }
 
 bool zone_manager::has_near( const zone_type_id &type, const tripoint &where, int range,
                              const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    for( const tripoint &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                return true;
-            }
+    for( const zone_box &box : get_boxes( type, fac ) ) {
+        if( where.z < box.start.z || where.z > box.end.z ) {
+            continue;
         }
-    }
-
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                return true;
-            }
+        if( square_dist( closest_point( box.start, box.end, where ), where ) <= range ) {
+            return true;
         }
     }
-
     return false;
 }
 
@@ -749,35 +728,33 @@ bool zone_manager::custom_loot_has( const tripoint &where, const item *it ) cons
 std::unordered_set<tripoint> zone_manager::get_near( const zone_type_id &type,
         const tripoint &where, int range, const item *it, const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
     auto near_point_set = std::unordered_set<tripoint>();
+    // whether the custom loot zones accept the item, the filter is only parsed once per zone
+    std::unordered_map<const zone_data *, bool> custom_accepts;
 
-    for( const tripoint &point : point_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                if( it && has( zone_type_id( "LOOT_CUSTOM" ), point ) ) {
-                    if( custom_loot_has( point, it ) ) {
-                        near_point_set.insert( point );
-                    }
-                } else {
-                    near_point_set.insert( point );
-                }
-            }
+    for( const zone_box &box : get_boxes( type, fac ) ) {
+        if( where.z < box.start.z || where.z > box.end.z ) {
+            continue;
         }
-    }
-
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint &point : vzone_set ) {
-        if( point.z == where.z ) {
-            if( square_dist( point, where ) <= range ) {
-                if( it && has( zone_type_id( "LOOT_CUSTOM" ), point ) ) {
-                    if( custom_loot_has( point, it ) ) {
-                        near_point_set.insert( point );
-                    }
-                } else {
-                    near_point_set.insert( point );
+        const tripoint start( std::max( box.start.x, where.x - range ),
+                              std::max( box.start.y, where.y - range ), where.z );
+        const tripoint end( std::min( box.end.x, where.x + range ),
+                            std::min( box.end.y, where.y + range ), where.z );
+        if( start.x > end.x || start.y > end.y ) {
+            continue;
+        }
+        for( const tripoint &point : tripoint_range<tripoint>( start, end ) ) {
+            if( it && has( zone_type_id( "LOOT_CUSTOM" ), point ) ) {
+                const zone_data *custom = get_zone_at( point, zone_type_id( "LOOT_CUSTOM" ) );
+                const auto accepts = custom_accepts.emplace( custom, false );
+                if( accepts.second ) {
+                    accepts.first->second = custom_loot_has( point, it );
+                }
+                if( !accepts.first->second ) {
+                    continue;
                 }
             }
+            near_point_set.insert( point );
         }
     }
 
@@ -793,21 +770,9 @@ cata::optional<tripoint> zone_manager::get_nearest( const zone_type_id &type, co
 
     tripoint nearest_pos = tripoint( INT_MIN, INT_MIN, INT_MIN );
     int nearest_dist = range + 1;
-    const std::unordered_set<tripoint> &point_set = get_point_set( type, fac );
-    for( const tripoint &p : point_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
-            }
-        }
-    }
-
-    const std::unordered_set<tripoint> &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint &p : vzone_set ) {
-        int cur_dist = square_dist( p, where );
+    for( const zone_box &box : get_boxes( type, fac ) ) {
+        const tripoint p = closest_point( box.start, box.end, where );
+        const int cur_dist = square_dist( p, where );
         if( cur_dist < nearest_dist ) {
             nearest_dist = cur_dist;
             nearest_pos = p;
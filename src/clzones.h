@@ -354,12 +354,18 @@ class zone_manager
         std::vector<zone_data> removed_vzones;
 
         std::map<zone_type_id, zone_type> types;
-        std::unordered_map<std::string, std::unordered_set<tripoint>> area_cache;
-        std::unordered_map<std::string, std::unordered_set<tripoint>> vzone_cache;
-        std::unordered_set<tripoint> get_point_set( const zone_type_id &type,
-                const faction_id &fac = your_fac ) const;
-        std::unordered_set<tripoint> get_vzone_set( const zone_type_id &type,
-                const faction_id &fac = your_fac ) const;
+        /** Area covered by a zone, both corners included. */
+        struct zone_box {
+            tripoint start;
+            tripoint end;
+        };
+        // Areas of the enabled zones by type hash.  Queries test the few boxes of a type
+        // instead of looking up (or iterating over) every point the zones cover.
+        std::unordered_map<std::string, std::vector<zone_box>> area_cache;
+        std::unordered_map<std::string, std::vector<zone_box>> vzone_cache;
+        /** Areas of zones and then of vehicle zones of the type. */
+        std::vector<zone_box> get_boxes( const zone_type_id &type,
+                                         const faction_id &fac = your_fac ) const;
 
         //Cache number of items already checked on each source tile when sorting
         std::unordered_map<tripoint, int> num_processed;
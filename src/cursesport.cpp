@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <unordered_map>
 
 #include "catacharset.h"
 #include "color.h"
@@ -23,10 +24,12 @@
  * and the actual text.
  * The text is split into lines (curseline), which contains cells (cursecell).
  * Each cell has individual foreground and background, and a character. The
- * character is an UTF-8 encoded string. It should be one or two console cells
- * width. If it's two cells width, the next cell in the line must be completely
- * empty (the string must not contain anything). Also the last cell of a line
- * must not contain a two cell width string.
+ * character is a code point, or a reference to a longer UTF-8 string (see
+ * cursecell::ch). It should be one or two console cells width. If it's two cells
+ * width, the next cell in the line must be completely empty (0). Also the last
+ * cell of a line must not contain a two cell width character.
+ * Each line keeps the span of cells changed since it was last drawn, so the
+ * backends only draw those.
  */
 
 //***********************************
@@ -36,6 +39,56 @@
 catacurses::window catacurses::stdscr;
 std::array<cata_cursesport::pairs, 100> cata_cursesport::colorpairs;   //storage for pair'ed colored
 
+namespace
+{
+// Glyphs that are not a single valid code point, see cursecell::ch.
+struct overflow_table {
+    std::vector<std::string> glyphs;
+    std::unordered_map<std::string, uint32_t> ids;
+};
+} // namespace
+
+static overflow_table &get_overflow_table()
+{
+    static overflow_table table;
+    return table;
+}
+
+uint32_t cata_cursesport::cursecell::encode( const std::string &ch )
+{
+    if( ch.empty() ) {
+        return 0;
+    }
+    const char *src = ch.c_str();
+    int len = ch.length();
+    const uint32_t first = UTF8_getch( &src, &len );
+    if( len == 0 && first != UNKNOWN_UNICODE && first != 0 ) {
+        return first;
+    }
+    overflow_table &table = get_overflow_table();
+    const auto iter = table.ids.emplace( ch, static_cast<uint32_t>( table.glyphs.size() ) );
+    if( iter.second ) {
+        table.glyphs.push_back( ch );
+    }
+    return overflow_bit | iter.first->second;
+}
+
+std::string cata_cursesport::cursecell::str() const
+{
+    if( ch & overflow_bit ) {
+        return get_overflow_table().glyphs[ch & ~overflow_bit];
+    }
+    return ch == 0 ? std::string() : utf32_to_utf8( ch );
+}
+
+uint32_t cata_cursesport::cursecell::codepoint() const
+{
+    if( ch & overflow_bit ) {
+        return UTF8_getch( get_overflow_table().glyphs[ch & ~overflow_bit] );
+    }
+    return ch;
+}
+
 static bool wmove_internal( const catacurses::window &win_, const point &p )
 {
     if( !win_ ) {
@@ -89,7 +142,7 @@ catacurses::window catacurses::newwin( int nlines, int ncols, const point &begin
 
     for( int j = 0; j < nlines; j++ ) {
         newwindow->line[j].chars.resize( ncols );
-        newwindow->line[j].touched = true; //Touch them all !?
+        newwindow->line[j].touch_all(); //Touch them all !?
     }
     return catacurses::window( std::shared_ptr<void>( newwindow, []( void *const w ) {
         delete static_cast<cata_cursesport::WINDOW *>( w );
@@ -107,11 +160,11 @@ static inline int newline( cata_cursesport::WINDOW *win )
 }
 
 // move the cursor a single cell, jumps to the next line if the
-// end of a line has been reached, also sets the touched flag.
+// end of a line has been reached, also marks the cell as changed.
 static inline void addedchar( cata_cursesport::WINDOW *win )
 {
+    win->line[win->cursor.y].touch( win->cursor.x );
     win->cursor.x++;
-    win->line[win->cursor.y].touched = true;
     if( win->cursor.x >= win->width ) {
         newline( win );
     }
@@ -220,10 +273,12 @@ void catacurses::wredrawln( const window &/*win*/, int /*beg_line*/, int /*num_l
 
 // Get a sequence of Unicode code points, store them in target
 // return the display width of the extracted string.
-static inline int fill( const char *&fmt, int &len, std::string &target )
+static inline int fill( const char *&fmt, int &len, cata_cursesport::cursecell &target )
 {
     const char *const start = fmt;
     int dlen = 0; // display width
+    int count = 0; // number of code points
+    uint32_t first = 0;
     const char *tmpptr = fmt; // pointer for UTF8_getch, which increments it
     int tmplen = len;
     while( tmplen > 0 ) {
@@ -237,7 +292,7 @@ static inline int fill( const char *&fmt, int &len, std::string &target )
             // First char is a control character: they only disturb the screen,
             // so replace it with a single space (e.g. instead of a '\t').
             // Newlines at the begin of a sequence are handled in printstring
-            target.assign( " ", 1 );
+            target.ch = ' ';
             len = tmplen;
             fmt = tmpptr;
             return 1; // the space
@@ -247,11 +302,19 @@ static inline int fill( const char *&fmt, int &len, std::string &target )
             // or by the next call to this function (replaced with a space).
             break;
         }
+        if( count++ == 0 ) {
+            first = ch;
+        }
         fmt = tmpptr;
         dlen += cw;
     }
-    target.assign( start, fmt - start );
-    len -= target.length();
+    if( count == 1 && first != UNKNOWN_UNICODE && first != 0 ) {
+        // the common case, no string needs to be built
+        target.ch = first;
+    } else {
+        target.ch = cata_cursesport::cursecell::encode( std::string( start, fmt - start ) );
+    }
+    len -= fmt - start;
     return dlen;
 }
 
@@ -286,9 +349,10 @@ static inline void printstring( cata_cursesport::WINDOW *win, const std::string
     if( win->cursor.y >= win->height || win->cursor.x >= win->width ) {
         return;
     }
-    if( win->cursor.x > 0 && win->line[win->cursor.y].chars[win->cursor.x].ch.empty() ) {
+    if( win->cursor.x > 0 && win->line[win->cursor.y].chars[win->cursor.x].empty() ) {
         // start inside a wide character, erase it for good
-        win->line[win->cursor.y].chars[win->cursor.x - 1].ch.assign( " " );
+        win->line[win->cursor.y].chars[win->cursor.x - 1].ch = ' ';
+        win->line[win->cursor.y].touch( win->cursor.x - 1 );
     }
     while( len > 0 ) {
         if( *fmt == '\n' ) {
@@ -303,7 +367,7 @@ static inline void printstring( cata_cursesport::WINDOW *win, const std::string
         if( curcell == nullptr ) {
             return;
         }
-        const int dlen = fill( fmt, len, curcell->ch );
+        const int dlen = fill( fmt, len, *curcell );
         if( dlen >= 1 ) {
             curcell->FG = win->FG;
             curcell->BG = win->BG;
@@ -313,8 +377,9 @@ static inline void printstring( cata_cursesport::WINDOW *win, const std::string
             // a wide character was converted to a narrow character leaving a null in the
             // following cell ~> clear it
             cursecell *seccell = cur_cell( win );
-            if( seccell && seccell->ch.empty() ) {
-                seccell->ch.assign( ' ', 1 );
+            if( seccell && seccell->empty() ) {
+                seccell->ch = ' ';
+                win->line[win->cursor.y].touch( win->cursor.x );
             }
         } else if( dlen == 2 ) {
             // the second cell, per definition must be empty
@@ -323,12 +388,12 @@ static inline void printstring( cata_cursesport::WINDOW *win, const std::string
                 // the previous cell was valid, this one is outside of the window
                 // --> the previous was the last cell of the last line
                 // --> there should not be a two-cell width character in the last cell
-                curcell->ch.assign( ' ', 1 );
+                curcell->ch = ' ';
                 return;
             }
             seccell->FG = win->FG;
             seccell->BG = win->BG;
-            seccell->ch.erase();
+            seccell->ch = 0;
             addedchar( win );
             // Have just written a wide-character into the last cell, it would not
             // display correctly if it was the last *cell* of a line
@@ -336,12 +401,13 @@ static inline void printstring( cata_cursesport::WINDOW *win, const std::string
                 // So make that last cell a space, move the width
                 // character in the first cell of the line
                 seccell->ch = curcell->ch;
-                curcell->ch.assign( 1, ' ' );
+                curcell->ch = ' ';
                 // and make the second cell on the new line empty.
                 addedchar( win );
                 cursecell *thicell = cur_cell( win );
                 if( thicell != nullptr ) {
-                    thicell->ch.erase();
+                    thicell->ch = 0;
+                    win->line[win->cursor.y].touch( win->cursor.x );
                 }
             }
         }
@@ -388,7 +454,7 @@ void catacurses::werase( const window &win_ )
 
     for( int j = 0; j < win->height; j++ ) {
         win->line[j].chars.assign( win->width, cata_cursesport::cursecell() );
-        win->line[j].touched = true;
+        win->line[j].touch_all();
     }
     win->draw = true;
     wmove( win_, point_zero );
@@ -444,7 +510,7 @@ void catacurses::wclear( const window &win_ )
     }
 
     for( int i = 0; i < win->pos.y && i < stdscr.get<cata_cursesport::WINDOW>()->height; i++ ) {
-        stdscr.get<cata_cursesport::WINDOW>()->line[i].touched = true;
+        stdscr.get<cata_cursesport::WINDOW>()->line[i].touch_all();
     }
 }
 
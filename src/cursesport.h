@@ -5,7 +5,9 @@
 #include <utility>
 #if defined(TILES) || defined(_WIN32)
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -33,23 +35,64 @@ struct pairs {
     base_color BG;
 };
 
-//Individual lines, so that we can track changed lines
+// A single cell of a window
 struct cursecell {
-    std::string ch;
+    /**
+     * The glyph in the cell: its code point, 0 for the second cell of a two cells wide glyph,
+     * or @ref overflow_bit and an index into a table of the glyphs that are not a single valid
+     * code point (e.g. a character with combining characters).
+     */
+    uint32_t ch = ' ';
     base_color FG = static_cast<base_color>( 0 );
     base_color BG = static_cast<base_color>( 0 );
 
-    explicit cursecell( std::string ch ) : ch( std::move( ch ) ) { }
-    cursecell() : cursecell( std::string( 1, ' ' ) ) { }
+    static constexpr uint32_t overflow_bit = 0x80000000;
+
+    explicit cursecell( const std::string &ch ) : ch( encode( ch ) ) { }
+    cursecell() = default;
+
+    /** Returns the value of @ref ch for an UTF-8 encoded glyph. */
+    static uint32_t encode( const std::string &ch );
+    /** The glyph as UTF-8, empty for the second cell of a wide glyph. */
+    std::string str() const;
+    /** The first code point of the glyph. */
+    uint32_t codepoint() const;
+    bool empty() const {
+        return ch == 0;
+    }
 
     bool operator==( const cursecell &b ) const {
         return FG == b.FG && BG == b.BG && ch == b.ch;
     }
 };
 
+// Individual lines, so that we can track changed cells
 struct curseline {
-    bool touched;
     std::vector<cursecell> chars;
+    // The cells changed since the line was last drawn are [dirty_begin, dirty_end).
+    int dirty_begin = 0;
+    int dirty_end = 0;
+
+    bool touched() const {
+        return dirty_begin < dirty_end;
+    }
+    void touch( int x ) {
+        if( touched() ) {
+            dirty_begin = std::min( dirty_begin, x );
+            dirty_end = std::max( dirty_end, x + 1 );
+        } else {
+            dirty_begin = x;
+            dirty_end = x + 1;
+        }
+    }
+    void touch_all() {
+        dirty_begin = 0;
+        dirty_end = static_cast<int>( chars.size() );
+    }
+    void untouch() {
+        dirty_begin = 0;
+        dirty_end = 0;
+    }
 };
 
 // The curses window struct
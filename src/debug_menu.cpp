@@ -87,6 +87,7 @@
 #include "player.h"
 #include "point.h"
 #include "popup.h"
+#include "profiler.h"
 #include "recipe_dictionary.h"
 #include "rng.h"
 #include "sounds.h"
@@ -193,6 +194,7 @@ std::string enum_to_string<debug_menu::debug_menu_index>( debug_menu::debug_menu
         case debug_menu::debug_menu_index::NESTED_MAPGEN: return "NESTED_MAPGEN";
         case debug_menu::debug_menu_index::VEHICLE_BATTERY_CHARGE: return "VEHICLE_BATTERY_CHARGE";
         case debug_menu::debug_menu_index::GENERATE_EFFECT_LIST: return "GENERATE_EFFECT_LIST";
+        case debug_menu::debug_menu_index::PROFILER: return "PROFILER";
         // *INDENT-ON*
         case debug_menu::debug_menu_index::last:
             break;
@@ -269,6 +271,7 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( debug_menu_index::SHOW_MUT_CAT, true, 'm', _( "Show mutation category levels" ) ) },
             { uilist_entry( debug_menu_index::BENCHMARK, true, 'b', _( "Draw benchmark (X seconds)" ) ) },
             { uilist_entry( debug_menu_index::HOUR_TIMER, true, 'E', _( "Toggle hour timer" ) ) },
+            { uilist_entry( debug_menu_index::PROFILER, true, 'P', _( "Turn profiler…" ) ) },
             { uilist_entry( debug_menu_index::TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( debug_menu_index::DISPLAY_NPC_PATH, true, 'n', _( "Toggle NPC pathfinding on map" ) ) },
             { uilist_entry( debug_menu_index::PRINT_FACTION_INFO, true, 'f', _( "Print faction info to console" ) ) },
@@ -1310,6 +1313,53 @@ void draw_benchmark( const int max_difference )
              difference / 1000.0, 1000.0 * draw_counter / static_cast<double>( difference ) );
 }
 
+void profiler_menu()
+{
+    if( !profiler::compiled_in() ) {
+        popup( _( "Profiler zones are not compiled into this build.  Rebuild with PROFILER enabled." ) );
+        return;
+    }
+    enum {
+        toggle, summary, trace, clear
+    };
+    uilist menu;
+    menu.text = _( "Turn profiler" );
+    menu.addentry( toggle, true, 't', profiler::enabled() ? _( "Stop recording" ) :
+                   _( "Start recording" ) );
+    menu.addentry( summary, true, 's', _( "Show summary of the last 100 turns" ) );
+    menu.addentry( trace, true, 'w', _( "Write Chrome trace file" ) );
+    menu.addentry( clear, true, 'c', _( "Clear recorded zones" ) );
+    menu.query();
+    switch( menu.ret ) {
+        case toggle:
+            profiler::set_enabled( !profiler::enabled() );
+            add_msg( m_info, profiler::enabled() ? _( "Profiler recording started." ) :
+                     _( "Profiler recording stopped." ) );
+            break;
+        case summary: {
+            const auto new_win = []() {
+                return catacurses::newwin( FULL_SCREEN_HEIGHT, FULL_SCREEN_WIDTH,
+                                           point( std::max( 0, ( TERMX - FULL_SCREEN_WIDTH ) / 2 ),
+                                                  std::max( 0, ( TERMY - FULL_SCREEN_HEIGHT ) / 2 ) ) );
+            };
+            scrollable_text( new_win, _( "Turn profiler" ), profiler::summary_text( 100 ) );
+            break;
+        }
+        case trace: {
+            const std::string path = PATH_INFO::user_dir() + "profiler_trace.json";
+            if( profiler::write_chrome_trace( path ) ) {
+                popup( _( "Trace written to %s" ), path );
+            }
+            break;
+        }
+        case clear:
+            profiler::clear();
+            break;
+        default:
+            break;
+    }
+}
+
 void debug()
 {
     bool debug_menu_has_hotkey = hotkey_for_action( ACTION_DEBUG,
@@ -1323,6 +1373,7 @@ void debug()
         debug_menu_index::GAME_REPORT,
         debug_menu_index::ENABLE_ACHIEVEMENTS,
         debug_menu_index::BENCHMARK,
+        debug_menu_index::PROFILER,
         debug_menu_index::SHOW_MSG,
     };
     bool should_disable_achievements = action && !non_cheaty_options.count( *action );
@@ -1832,6 +1883,9 @@ void debug()
         case debug_menu_index::HOUR_TIMER:
             g->toggle_debug_hour_timer();
             break;
+        case debug_menu_index::PROFILER:
+            debug_menu::profiler_menu();
+            break;
         case debug_menu_index::CHANGE_TIME: {
             auto set_turn = [&]( const int initial, const time_duration & factor, const char *const msg ) {
                 const auto text = string_input_popup()
@@ -86,6 +86,7 @@ enum class debug_menu_index : int {
     NESTED_MAPGEN,
     VEHICLE_BATTERY_CHARGE,
     GENERATE_EFFECT_LIST,
+    PROFILER,
     last
 };
 
@@ -103,6 +104,7 @@ void wishskill( player *p );
 void wishproficiency( player *p );
 void mutation_wish();
 void draw_benchmark( int max_difference );
+void profiler_menu();
 
 void debug();
 
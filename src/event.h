@@ -7,6 +7,7 @@
 #include <cstdlib>
 #include <iosfwd>
 #include <map>
+#include <stdexcept>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -732,16 +733,45 @@ struct event_spec<event_type::uses_debug_menu> {
 template<event_type Type, typename IndexSequence>
 struct make_event_helper;
 
+constexpr bool same_field_name( const char *a, const char *b )
+{
+    return *a == *b && ( *a == '\0' || same_field_name( a + 1, b + 1 ) );
+}
+
+// Throws for a name not in the event_spec, which makes it fail to compile when evaluated as a
+// constant expression.
+template<event_type Type>
+constexpr size_t field_index( const char *name, size_t i )
+{
+    return i == event_spec<Type>::fields.size() ?
+           throw std::invalid_argument( "no field of that name in the event_spec" ) :
+           same_field_name( event_spec<Type>::fields[i].first, name ) ? i :
+           field_index<Type>( name, i + 1 );
+}
+
 } // namespace event_detail
 
+// The data of an event made by event::make is kept in the order of the
+// fields of its event_spec, so such an event takes no allocation to build and
+// its fields can be read by index without comparing names.
 class event
 {
     public:
         using data_type = std::map<std::string, cata_variant>;
+        using field_type = std::pair<const char *, cata_variant_type>;
 
+        // The most fields of any event_spec.
+        static constexpr size_t max_fields = 6;
+        using values_type = std::array<cata_variant, max_fields>;
+
+        // For events whose fields are not those of their type's event_spec,
+        // like the ones event transformations make.  Their fields can only be
+        // read by name.
         event( event_type type, time_point time, data_type &&data )
             : type_( type )
             , time_( time )
+            , fields_( nullptr )
+            , num_fields_( 0 )
             , data_( std::move( data ) )
         {}
 
@@ -757,12 +787,22 @@ class event
                            "spec for this event type must be defined and empty" );
             static_assert( sizeof...( Args ) == Spec::fields.size(),
                            "wrong number of arguments for event type" );
+            static_assert( Spec::fields.size() <= max_fields,
+                           "increase event::max_fields for this event type" );
 
             return event_detail::make_event_helper <
                    Type, std::make_index_sequence<sizeof...( Args )>
                    > ()( calendar::turn, std::forward<Args>( args )... );
         }
 
+        // The index of the field called name in events of the given type, for
+        // the overloads of get taking an index.  Keep the result in a constexpr
+        // variable, so that a name the event_spec does not have fails to compile.
+        template<event_type Type>
+        static constexpr size_t field_index( const char *name ) {
+            return event_detail::field_index<Type>( name, 0 );
+        }
+
         using fields_type = std::unordered_map<std::string, cata_variant_type>;
         static fields_type get_fields( event_type );
 
@@ -773,22 +813,57 @@ class event
             return time_;
         }
 
-        cata_variant get_variant( const std::string &key ) const {
-            auto it = data_.find( key );
-            if( it == data_.end() ) {
+        // The fields of an event made by make, in the order of its event_spec.
+        // Null for other events.
+        const field_type *spec_fields() const {
+            return fields_;
+        }
+        size_t num_fields() const {
+            return num_fields_;
+        }
+        // The values of the fields of an event made by make, the ones past
+        // num_fields are void.
+        const values_type &values() const {
+            return values_;
+        }
+        const char *field_name( size_t index ) const {
+            return fields_[index].first;
+        }
+
+        const cata_variant &get_variant( size_t index ) const {
+            if( index >= num_fields_ ) {
+                debugmsg( "No field %d in event of type %s", index, io::enum_to_string( type_ ) );
+                abort();
+            }
+            return values_[index];
+        }
+
+        const cata_variant &get_variant( const std::string &key ) const {
+            const cata_variant *value = find_field( key );
+            if( value == nullptr ) {
                 debugmsg( "No such key %s in event of type %s", key,
                           io::enum_to_string( type_ ) );
                 abort();
             }
-            return it->second;
+            return *value;
         }
 
         cata_variant get_variant_or_void( const std::string &key ) const {
-            auto it = data_.find( key );
-            if( it == data_.end() ) {
+            const cata_variant *value = find_field( key );
+            if( value == nullptr ) {
                 return cata_variant();
             }
-            return it->second;
+            return *value;
+        }
+
+        template<cata_variant_type Type>
+        auto get( size_t index ) const {
+            return get_variant( index ).get<Type>();
+        }
+
+        template<typename T>
+        auto get( size_t index ) const {
+            return get_variant( index ).get<T>();
         }
 
         template<cata_variant_type Type>
@@ -801,13 +876,51 @@ class event
             return get_variant( key ).get<T>();
         }
 
+        // The fields by name, the form event transformations read events in.
+        // For an event made by make, the map is built on first use and then
+        // kept, as every transformation watching the event type asks for it.
         const data_type &data() const {
+            if( fields_ != nullptr && data_.size() != num_fields_ ) {
+                for( size_t i = 0; i < num_fields_; ++i ) {
+                    data_.emplace( fields_[i].first, values_[i] );
+                }
+            }
             return data_;
         }
     private:
+        template<event_type Type, typename IndexSequence>
+        friend struct event_detail::make_event_helper;
+
+        event( event_type type, time_point time, const field_type *fields, size_t num_fields,
+               values_type &&values )
+            : type_( type )
+            , time_( time )
+            , fields_( fields )
+            , num_fields_( num_fields )
+            , values_( std::move( values ) )
+        {}
+
+        const cata_variant *find_field( const std::string &key ) const {
+            if( fields_ == nullptr ) {
+                const auto it = data_.find( key );
+                return it == data_.end() ? nullptr : &it->second;
+            }
+            for( size_t i = 0; i < num_fields_; ++i ) {
+                if( key == fields_[i].first ) {
+                    return &values_[i];
+                }
+            }
+            return nullptr;
+        }
+
         event_type type_;
         time_point time_;
-        data_type data_;
+        // The fields of the event_spec for type_, null if the fields are in data_
+        const field_type *fields_;
+        size_t num_fields_;
+        values_type values_;
+        // The fields by name: all of them if fields_ is null, else built by data()
+        mutable data_type data_;
 };
 
 namespace event_detail
@@ -822,10 +935,11 @@ struct make_event_helper<Type, std::index_sequence<I...>> {
         return event(
                    Type,
                    time,
-        std::map<std::string, cata_variant> { {
-                Spec::fields[I].first,
-                cata_variant::make<Spec::fields[I].second>( args )
-            } ...
+                   Spec::fields.data(),
+                   Spec::fields.size(),
+        event::values_type { {
+                cata_variant::make<Spec::fields[I].second>( args )...
+            }
         } );
     }
 };
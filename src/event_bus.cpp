@@ -39,6 +39,21 @@ event_bus::~event_bus()
 void event_bus::subscribe( event_subscriber *s )
 {
     subscribers.push_back( s );
+    for( std::vector<event_subscriber *> &by_type : subscribers_by_type ) {
+        by_type.push_back( s );
+    }
+    s->on_subscribe( this );
+}
+
+void event_bus::subscribe( event_subscriber *s, const std::vector<event_type> &types )
+{
+    subscribers.push_back( s );
+    for( const event_type type : types ) {
+        std::vector<event_subscriber *> &by_type = subscribers_by_type[static_cast<size_t>( type )];
+        if( std::find( by_type.begin(), by_type.end(), s ) == by_type.end() ) {
+            by_type.push_back( s );
+        }
+    }
     s->on_subscribe( this );
 }
 
@@ -50,12 +65,15 @@ void event_bus::unsubscribe( event_subscriber *s )
     } else {
         ( *it )->on_unsubscribe( this );
         subscribers.erase( it );
+        for( std::vector<event_subscriber *> &by_type : subscribers_by_type ) {
+            by_type.erase( std::remove( by_type.begin(), by_type.end(), s ), by_type.end() );
+        }
     }
 }
 
 void event_bus::send( const cata::event &e ) const
 {
-    for( event_subscriber *s : subscribers ) {
+    for( event_subscriber *s : subscribers_by_type[static_cast<size_t>( e.type() )] ) {
         s->notify( e );
     }
 }
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_EVENT_BUS_H
 #define CATA_SRC_EVENT_BUS_H
 
+#include <array>
 #include <type_traits>
 #include <vector>
 
@@ -16,7 +17,10 @@ class event_bus
         event_bus( const event_bus & ) = delete;
         event_bus &operator=( const event_bus & ) = delete;
         ~event_bus();
+        /** Subscribes to every event. */
         void subscribe( event_subscriber * );
+        /** Subscribes to the events of the given types only. */
+        void subscribe( event_subscriber *, const std::vector<event_type> &types );
         void unsubscribe( event_subscriber * );
 
         void send( const cata::event & ) const;
@@ -26,6 +30,9 @@ class event_bus
         }
     private:
         std::vector<event_subscriber *> subscribers;
+        // The subscribers to each event type, in the order they subscribed
+        std::array<std::vector<event_subscriber *>,
+            static_cast<size_t>( event_type::num_event_types )> subscribers_by_type;
 };
 
 event_bus &get_event_bus();
@@ -520,9 +520,9 @@ struct event_transformation_impl : public event_transformation::impl {
             trans->source_->add_watcher( stats, this );
             for( const auto &p : trans->constraints_ ) {
                 if( p.second.equals_statistic_ ) {
-                    // TODO: we need a version of value_constraint that is
-                    // itself a watcher so that it can cache the statistic
-                    // value it cares about and not constantly recompute it.
+                    // Watching the statistic also means the stats_tracker
+                    // keeps its value, so the value_constraint does not
+                    // recompute it for each event.
                     stats.add_watcher( *p.second.equals_statistic_, this );
                 }
             }
@@ -547,6 +547,10 @@ struct event_transformation_impl : public event_transformation::impl {
             stats.transformed_set_changed( transformation_->id_, data_ );
         }
 
+        const event_multiset &get_events() const override {
+            return data_;
+        }
+
         const event_transformation_impl *transformation_;
         event_multiset data_;
     };
@@ -900,7 +904,8 @@ struct event_statistic_unique_value : event_statistic_field_summary<false> {
     using event_statistic_field_summary::event_statistic_field_summary;
 
     cata_variant value( stats_tracker &stats ) const override {
-        const event_multiset::summaries_type summaries = source->get( stats ).counts();
+        const event_multiset events = source->get( stats );
+        const event_multiset::summaries_type &summaries = events.counts();
         if( summaries.size() != 1 ) {
             return cata_variant();
         }
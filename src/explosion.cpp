@@ -9,9 +9,7 @@
 #include <limits>
 #include <map>
 #include <memory>
-#include <queue>
 #include <random>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -46,6 +44,7 @@
 #include "npc.h"
 #include "optional.h"
 #include "point.h"
+#include "profiler.h"
 #include "projectile.h"
 #include "rng.h"
 #include "shadowcasting.h"
@@ -150,6 +149,95 @@ static float gurney_spherical( const double charge, const double mass )
                                          -0.5 ) * TYPICAL_GURNEY_CONSTANT );
 }
 
+namespace
+{
+struct blast_cell {
+    /** Shortest distance the blast reached the square with, unreached if it did not. */
+    float dist = unreached;
+    bool closed = false;
+    bool bashed = false;
+
+    static constexpr float unreached = std::numeric_limits<float>::max();
+};
+
+/**
+ * The squares a blast can reach, stored densely over their bounding box, and the queue of
+ * squares to spread the blast from.
+ *
+ * The queue keeps a bucket per square of distance.  A step costs at least a square, so the
+ * squares of a bucket only queue squares of later buckets, and sorting a bucket when it is
+ * reached takes its squares in the same order as a priority queue would.
+ */
+class blast_grid
+{
+    public:
+        void reset( const tripoint &min, const tripoint &max ) {
+            origin = min;
+            size = max - min + tripoint( 1, 1, 1 );
+            cells.assign( static_cast<size_t>( size.x ) * size.y * size.z, blast_cell() );
+            for( std::vector<std::pair<float, int>> &bucket : buckets ) {
+                bucket.clear();
+            }
+            next_bucket = 0;
+        }
+
+        bool contains( const tripoint &p ) const {
+            return p.x >= origin.x && p.y >= origin.y && p.z >= origin.z &&
+                   p.x < origin.x + size.x && p.y < origin.y + size.y && p.z < origin.z + size.z;
+        }
+        // Ordered like tripoint::operator<, so the squares are visited in the order a
+        // std::set<tripoint> of them would be.
+        int index( const tripoint &p ) const {
+            return ( ( p.x - origin.x ) * size.y + p.y - origin.y ) * size.z + p.z - origin.z;
+        }
+        tripoint pos( const int index ) const {
+            return origin + tripoint( index / ( size.y * size.z ), index / size.z % size.y,
+                                      index % size.z );
+        }
+        blast_cell &at( const int index ) {
+            return cells[index];
+        }
+        int cell_count() const {
+            return static_cast<int>( cells.size() );
+        }
+        bool is_closed( const tripoint &p ) const {
+            return contains( p ) && cells[index( p )].closed;
+        }
+
+        void push( const float dist, const int index ) {
+            const size_t bucket = static_cast<size_t>( dist );
+            if( bucket >= buckets.size() ) {
+                buckets.resize( bucket + 1 );
+            }
+            buckets[bucket].emplace_back( dist, index );
+        }
+        /** Takes the squares of a bucket, closest first, into @p open. */
+        bool pop_bucket( std::vector<std::pair<float, int>> &open ) {
+            open.clear();
+            while( next_bucket < buckets.size() && buckets[next_bucket].empty() ) {
+                next_bucket++;
+            }
+            if( next_bucket == buckets.size() ) {
+                next_bucket = 0;
+                return false;
+            }
+            open.swap( buckets[next_bucket] );
+            std::sort( open.begin(), open.end(), []( const std::pair<float, int> &a,
+            const std::pair<float, int> &b ) {
+                return a.first < b.first;
+            } );
+            return true;
+        }
+
+    private:
+        tripoint origin;
+        tripoint size;
+        std::vector<blast_cell> cells;
+        std::vector<std::vector<std::pair<float, int>>> buckets;
+        size_t next_bucket = 0;
+};
+} // namespace
+
 // (C1001) Compiler Internal Error on Visual Studio 2015 with Update 2
 static void do_blast( const tripoint &p, const float power,
                       const float distance_factor, const bool fire )
@@ -169,99 +257,133 @@ static void do_blast( const tripoint &p, const float power,
 
     here.bash( p, fire ? power : ( 2 * power ), true, false, false );
 
-    std::priority_queue< std::pair<float, tripoint>, std::vector< std::pair<float, tripoint> >, pair_greater_cmp_first >
-    open;
-    std::set<tripoint> closed;
-    std::set<tripoint> bashed{ p };
-    std::map<tripoint, float> dist_map;
-    open.push( std::make_pair( 0.0f, p ) );
-    dist_map[p] = 0.0f;
+    // The blast only spreads from squares it reaches with a force over 1, i.e. closer than
+    // max_dist, and every step costs at least tile_dist.
+    const float max_dist = distance_factor < 1.0f ?
+                           std::log( std::max( power, 1.0f ) ) / -std::log( distance_factor ) :
+                           static_cast<float>( MAPSIZE_X );
+    const int reach = static_cast<int>( std::min( max_dist, static_cast<float>( MAPSIZE_X ) ) ) + 2;
+    const tripoint min_p( std::max( p.x - reach, 0 ), std::max( p.y - reach, 0 ),
+                          here.has_zlevels() ? std::max( p.z - reach, -OVERMAP_DEPTH ) : p.z );
+    const tripoint max_p( std::min( p.x + reach, MAPSIZE_X - 1 ),
+                          std::min( p.y + reach, MAPSIZE_Y - 1 ),
+                          here.has_zlevels() ? std::min( p.z + reach, OVERMAP_HEIGHT ) : p.z );
+
+    // Reused between blasts, taken out while in use in case a blast sets off another one.
+    static blast_grid scratch;
+    blast_grid grid;
+    std::swap( grid, scratch );
+    grid.reset( min_p, max_p );
+
+    blast_cell &origin = grid.at( grid.index( p ) );
+    origin.dist = 0.0f;
+    origin.bashed = true;
+    grid.push( 0.0f, grid.index( p ) );
+    std::vector<std::pair<float, int>> open;
     // Find all points to blast
-    while( !open.empty() ) {
-        // Add some random factor to effective distance to make it look cooler
-        const float distance = open.top().first * rng_float( 1.0f, 1.2f );
-        const tripoint pt = open.top().second;
-        open.pop();
-
-        if( closed.count( pt ) != 0 ) {
-            continue;
-        }
-
-        closed.insert( pt );
-
-        const float force = power * std::pow( distance_factor, distance );
-        if( force <= 1.0f ) {
-            continue;
-        }
+    while( grid.pop_bucket( open ) ) {
+        for( const std::pair<float, int> &top : open ) {
+            // Add some random factor to effective distance to make it look cooler
+            const float distance = top.first * rng_float( 1.0f, 1.2f );
+            blast_cell &cell = grid.at( top.second );
+            if( cell.closed ) {
+                continue;
+            }
 
-        if( here.impassable( pt ) && pt != p ) {
-            // Don't propagate further
-            continue;
-        }
+            cell.closed = true;
+            const tripoint pt = grid.pos( top.second );
 
-        // Those will be used for making "shaped charges"
-        // Don't check up/down (for now) - this will make 2D/3D balancing easier
-        int empty_neighbors = 0;
-        for( size_t i = 0; i < 8; i++ ) {
-            tripoint dest( pt + tripoint( x_offset[i], y_offset[i], z_offset[i] ) );
-            if( closed.count( dest ) == 0 && here.valid_move( pt, dest, false, true ) ) {
-                empty_neighbors++;
+            const float force = power * std::pow( distance_factor, distance );
+            if( force <= 1.0f ) {
+                continue;
             }
-        }
 
-        empty_neighbors = std::max( 1, empty_neighbors );
-        // Iterate over all neighbors. Bash all of them, propagate to some
-        for( size_t i = 0; i < max_index; i++ ) {
-            tripoint dest( pt + tripoint( x_offset[i], y_offset[i], z_offset[i] ) );
-            if( closed.count( dest ) != 0 || !here.inbounds( dest ) ) {
+            if( here.impassable( pt ) && pt != p ) {
+                // Don't propagate further
                 continue;
             }
 
-            if( bashed.count( dest ) == 0 ) {
-                bashed.insert( dest );
-                // Up to 200% bonus for shaped charge
-                // But not if the explosion is fiery, then only half the force and no bonus
-                const float bash_force = !fire ?
-                                         force + ( 2 * force / empty_neighbors ) :
-                                         force / 2;
-                if( z_offset[i] == 0 ) {
-                    // Horizontal - no floor bashing
-                    here.bash( dest, bash_force, true, false, false );
-                } else if( z_offset[i] > 0 ) {
-                    // Should actually bash through the floor first, but that's not really possible yet
-                    here.bash( dest, bash_force, true, false, true );
-                } else if( !here.valid_move( pt, dest, false, true ) ) {
-                    // Only bash through floor if it doesn't exist
-                    // Bash the current tile's floor, not the one's below
-                    here.bash( pt, bash_force, true, false, true );
+            // Those will be used for making "shaped charges"
+            // Don't check up/down (for now) - this will make 2D/3D balancing easier
+            int empty_neighbors = 0;
+            for( size_t i = 0; i < 8; i++ ) {
+                tripoint dest( pt + tripoint( x_offset[i], y_offset[i], z_offset[i] ) );
+                if( !grid.is_closed( dest ) && here.valid_move( pt, dest, false, true ) ) {
+                    empty_neighbors++;
                 }
             }
 
-            float next_dist = distance;
-            next_dist += ( x_offset[i] == 0 || y_offset[i] == 0 ) ? tile_dist : diag_dist;
-            if( z_offset[i] != 0 ) {
-                if( !here.valid_move( pt, dest, false, true ) ) {
+            empty_neighbors = std::max( 1, empty_neighbors );
+            // Iterate over all neighbors. Bash all of them, propagate to some
+            for( size_t i = 0; i < max_index; i++ ) {
+                tripoint dest( pt + tripoint( x_offset[i], y_offset[i], z_offset[i] ) );
+                if( !grid.contains( dest ) ) {
+                    continue;
+                }
+                const int dest_index = grid.index( dest );
+                blast_cell &dest_cell = grid.at( dest_index );
+                if( dest_cell.closed ) {
                     continue;
                 }
 
-                next_dist += zlev_dist;
-            }
+                if( !dest_cell.bashed ) {
+                    dest_cell.bashed = true;
+                    // Up to 200% bonus for shaped charge
+                    // But not if the explosion is fiery, then only half the force and no bonus
+                    const float bash_force = !fire ?
+                                             force + ( 2 * force / empty_neighbors ) :
+                                             force / 2;
+                    if( z_offset[i] == 0 ) {
+                        // Horizontal - no floor bashing
+                        here.bash( dest, bash_force, true, false, false );
+                    } else if( z_offset[i] > 0 ) {
+                        // Should actually bash through the floor first, but that's not really possible yet
+                        here.bash( dest, bash_force, true, false, true );
+                    } else if( !here.valid_move( pt, dest, false, true ) ) {
+                        // Only bash through floor if it doesn't exist
+                        // Bash the current tile's floor, not the one's below
+                        here.bash( pt, bash_force, true, false, true );
+                    }
+                }
+
+                float next_dist = distance;
+                next_dist += ( x_offset[i] == 0 || y_offset[i] == 0 ) ? tile_dist : diag_dist;
+                if( z_offset[i] != 0 ) {
+                    if( !here.valid_move( pt, dest, false, true ) ) {
+                        continue;
+                    }
 
-            if( dist_map.count( dest ) == 0 || dist_map[dest] > next_dist ) {
-                open.push( std::make_pair( next_dist, dest ) );
-                dist_map[dest] = next_dist;
+                    next_dist += zlev_dist;
+                }
+
+                if( dest_cell.dist > next_dist ) {
+                    grid.push( next_dist, dest_index );
+                    dest_cell.dist = next_dist;
+                }
             }
         }
     }
 
+    // The damage is only dealt once the blast has spread, collect where it goes.
+    std::vector<std::pair<tripoint, float>> blasted;
+    for( int index = 0; index < grid.cell_count(); index++ ) {
+        const blast_cell &cell = grid.at( index );
+        if( cell.closed ) {
+            blasted.emplace_back( grid.pos( index ),
+                                  power * std::pow( distance_factor, cell.dist ) );
+        }
+    }
+    std::swap( grid, scratch );
+
     // Draw the explosion
     std::map<tripoint, nc_color> explosion_colors;
-    for( const tripoint &pt : closed ) {
+    for( const std::pair<tripoint, float> &blast : blasted ) {
+        const tripoint &pt = blast.first;
         if( here.impassable( pt ) ) {
             continue;
         }
 
-        const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+        const float force = blast.second;
         nc_color col = c_red;
         if( force < 10 ) {
             col = c_white;
@@ -274,8 +396,9 @@ static void do_blast( const tripoint &p, const float power,
 
     draw_custom_explosion( get_player_character().pos(), explosion_colors );
 
-    for( const tripoint &pt : closed ) {
-        const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+    for( const std::pair<tripoint, float> &blast : blasted ) {
+        const tripoint &pt = blast.first;
+        const float force = blast.second;
         if( force < 1.0f ) {
             // Too weak to matter
             continue;
@@ -587,22 +710,29 @@ void flashbang( const tripoint &p, bool player_immune )
                                              time_duration::from_turns( 10 - dist ) );
         }
     }
+    std::vector<monster *> affected;
+    std::vector<tripoint> affected_pos;
     for( monster &critter : g->all_monsters() ) {
-        if( critter.type->in_species( species_ROBOT ) ) {
+        if( critter.type->in_species( species_ROBOT ) || rl_dist( critter.pos(), p ) > 8 ) {
             continue;
         }
+        affected.push_back( &critter );
+        affected_pos.push_back( critter.pos() );
+    }
+    // Line of sight is symmetric, so trace the lines to all monsters from the flash in one batch.
+    const std::vector<bool> sees_flash = here.sees( p, affected_pos, 8 );
+    for( size_t i = 0; i < affected.size(); ++i ) {
+        monster &critter = *affected[i];
         // TODO: can the following code be called for all types of creatures
         dist = rl_dist( critter.pos(), p );
-        if( dist <= 8 ) {
-            if( dist <= 4 ) {
-                critter.add_effect( effect_stunned, time_duration::from_turns( 10 - dist ) );
-            }
-            if( critter.has_flag( MF_SEES ) && here.sees( critter.pos(), p, 8 ) ) {
-                critter.add_effect( effect_blind, time_duration::from_turns( 18 - dist ) );
-            }
-            if( critter.has_flag( MF_HEARS ) ) {
-                critter.add_effect( effect_deaf, time_duration::from_turns( 60 - dist * 4 ) );
-            }
+        if( dist <= 4 ) {
+            critter.add_effect( effect_stunned, time_duration::from_turns( 10 - dist ) );
+        }
+        if( critter.has_flag( MF_SEES ) && sees_flash[i] ) {
+            critter.add_effect( effect_blind, time_duration::from_turns( 18 - dist ) );
+        }
+        if( critter.has_flag( MF_HEARS ) ) {
+            critter.add_effect( effect_deaf, time_duration::from_turns( 60 - dist * 4 ) );
         }
     }
     sounds::sound( p, 12, sounds::sound_t::combat, _( "a huge boom!" ), false, "misc", "flashbang" );
@@ -868,6 +998,7 @@ void resonance_cascade( const tripoint &p )
 
 void process_explosions()
 {
+    CATA_PROFILE_ZONE( "explosion_handler::process_explosions" );
     for( const queued_explosion &ex : _explosions ) {
         _make_explosion( ex.first, ex.second );
     }
@@ -1,8 +1,11 @@
 #include "flag.h"
 
+#include <cstddef>
 
 #include "debug.h"
+#include "flag_bitset.h"
 #include "generic_factory.h"
+#include "int_id.h"
 #include "json.h"
 #include "type_id.h"
 
@@ -410,3 +413,33 @@ const std::vector<json_flag> &json_flag::get_all()
 {
     return json_flags_all.get_all();
 }
+
+int flag_bitset::bit_of( const flag_id &f )
+{
+    return json_flags_all.convert( f, int_id<json_flag>( -1 ), false ).to_i();
+}
+
+void flag_bitset::set( const flag_id &f )
+{
+    const int bit = bit_of( f );
+    if( bit < 0 ) {
+        return;
+    }
+    const size_t word = static_cast<size_t>( bit ) / 64;
+    if( word >= words.size() ) {
+        words.resize( word + 1, 0 );
+    }
+    words[word] |= static_cast<uint64_t>( 1 ) << ( bit % 64 );
+}
+
+void flag_bitset::reset( const flag_id &f )
+{
+    const int bit = bit_of( f );
+    if( bit < 0 ) {
+        return;
+    }
+    const size_t word = static_cast<size_t>( bit ) / 64;
+    if( word < words.size() ) {
+        words[word] &= ~( static_cast<uint64_t>( 1 ) << ( bit % 64 ) );
+    }
+}
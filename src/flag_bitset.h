@@ -0,0 +1,59 @@
+#pragma once
+#ifndef CATA_SRC_FLAG_BITSET_H
+#define CATA_SRC_FLAG_BITSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "type_id.h"
+
+/**
+ * A set of flags stored as one bit per loaded flag, indexed by the flag's int id
+ * (its position among the loaded json_flag definitions).  Testing for a flag is a
+ * couple of word operations instead of a std::set lookup.  Implemented in flag.cpp,
+ * next to the flag definitions.
+ *
+ * The int ids are only valid for the currently loaded flags: anything keeping a
+ * flag_bitset must rebuild it when the game data is reloaded.  Invalid flags
+ * are never members.
+ */
+class flag_bitset
+{
+    public:
+        /**
+         * The bit standing for @p f, or -1 if it is not a loaded flag.  Callers testing
+         * one flag against several bitsets should resolve it once and test the bit.
+         */
+        static int bit_of( const flag_id &f );
+
+        bool test( const int bit ) const {
+            const size_t word = static_cast<size_t>( bit ) / 64;
+            return bit >= 0 && word < words.size() && ( words[word] >> ( bit % 64 ) & 1 ) != 0;
+        }
+        bool test( const flag_id &f ) const {
+            return test( bit_of( f ) );
+        }
+        void set( const flag_id &f );
+        void reset( const flag_id &f );
+        void clear() {
+            words.clear();
+        }
+        /** True if no flag was ever set since the last @ref clear. */
+        bool empty() const {
+            return words.empty();
+        }
+
+        template<typename Container>
+        void assign( const Container &flags ) {
+            clear();
+            for( const flag_id &f : flags ) {
+                set( f );
+            }
+        }
+
+    private:
+        std::vector<uint64_t> words;
+};
+
+#endif // CATA_SRC_FLAG_BITSET_H
@@ -127,6 +127,7 @@
 #include "mtype.h"
 #include "npc.h"
 #include "npc_class.h"
+#include "npc_perception.h"
 #include "omdata.h"
 #include "options.h"
 #include "output.h"
@@ -142,6 +143,7 @@
 #include "player_activity.h"
 #include "popup.h"
 #include "profession.h"
+#include "profiler.h"
 #include "recipe.h"
 #include "recipe_dictionary.h"
 #include "ret_val.h"
@@ -347,10 +349,13 @@ game::game() :
     first_redraw_since_waiting_started = true;
     reset_light_level();
     events().subscribe( &*stats_tracker_ptr );
-    events().subscribe( &*kill_tracker_ptr );
+    events().subscribe( &*kill_tracker_ptr, {
+        event_type::character_kills_character, event_type::character_kills_monster
+    } );
     events().subscribe( &*memorial_logger_ptr );
-    events().subscribe( &*achievements_tracker_ptr );
-    events().subscribe( &*spell_events_ptr );
+    // the achievements are tracked through the stats_tracker
+    events().subscribe( &*achievements_tracker_ptr, { event_type::game_start } );
+    events().subscribe( &*spell_events_ptr, { event_type::player_levels_spell } );
     world_generator = std::make_unique<worldfactory>();
     // do nothing, everything that was in here is moved to init_data() which is called immediately after g = new game; in main.cpp
     // The reason for this move is so that g is not uninitialized when it gets to installing the parts into vehicles.
@@ -1412,6 +1417,8 @@ void game::calc_driving_offset( vehicle *veh )
 // Returns true if game is over (death, saved, quit, etc)
 bool game::do_turn()
 {
+    CATA_PROFILE_TURN();
+    CATA_PROFILE_ZONE_NAMED( turn_zone, "game::do_turn" );
     if( is_game_over() ) {
         return cleanup_at_end();
     }
@@ -1485,6 +1492,8 @@ bool game::do_turn()
         sfx::do_hearing_loss();
     }
 
+    // The player's turn waits for input, keep it out of the turn timings.
+    CATA_PROFILE_ZONE_END( turn_zone );
     if( !u.has_effect( efftype_id( "sleep" ) ) || uquit == QUIT_WATCH ) {
         if( u.moves > 0 || uquit == QUIT_WATCH ) {
             while( u.moves > 0 || uquit == QUIT_WATCH ) {
@@ -1552,6 +1561,7 @@ bool game::do_turn()
         }
     }
 
+    CATA_PROFILE_ZONE( "game::do_turn_world" );
     if( driving_view_offset.x != 0 || driving_view_offset.y != 0 ) {
         // Still have a view offset, but might not be driving anymore,
         // or the option has been deactivated,
@@ -1588,6 +1598,11 @@ bool game::do_turn()
     if( calendar::once_every( 5_minutes ) ) {
         overmap_npc_move();
     }
+    overmap_buffer.process_prefetch();
+    m.process_prefetch();
+    if( calendar::once_every( 1_minutes ) ) {
+        MAPBUFFER.unload_cold( static_cast<size_t>( get_option<int>( "MAP_MEMORY_BUDGET" ) ) << 20 );
+    }
     if( calendar::once_every( 10_seconds ) ) {
         for( const tripoint &elem : m.get_furn_field_locations() ) {
             const furn_t &furn = *m.furn( elem );
@@ -1696,6 +1711,7 @@ void game::set_driving_view_offset( const point &p )
 
 void game::process_activity()
 {
+    CATA_PROFILE_ZONE( "game::process_activity" );
     if( !u.activity ) {
         return;
     }
@@ -2915,6 +2931,7 @@ bool game::load( const std::string &world )
 
 bool game::load( const save_t &name )
 {
+    CATA_PROFILE_ZONE( "game::load" );
     background_pane background;
     static_popup popup;
     popup.message( "%s", _( "Please wait…\nLoading the save…" ) );
@@ -2936,6 +2953,7 @@ bool game::load( const save_t &name )
         return false;
     }
 
+    u.set_map_memory_path( playerpath + SAVE_EXTENSION_MAP_MEMORY_REGIONS );
     read_from_file_optional_json( playerpath + SAVE_EXTENSION_MAP_MEMORY, [&]( JsonIn & jsin ) {
         u.deserialize_map_memory( jsin );
     } );
@@ -3147,8 +3165,9 @@ bool game::save_player_data()
     const bool saved_data = write_to_file( playerfile + SAVE_EXTENSION, [&]( std::ostream & fout ) {
         serialize( fout );
     }, _( "player data" ) );
-    const bool saved_map_memory = write_to_file( playerfile + SAVE_EXTENSION_MAP_MEMORY, [&](
-    std::ostream & fout ) {
+    u.set_map_memory_path( playerfile + SAVE_EXTENSION_MAP_MEMORY_REGIONS );
+    const bool saved_map_memory = u.save_map_memory_regions() &&
+    write_to_file( playerfile + SAVE_EXTENSION_MAP_MEMORY, [&]( std::ostream & fout ) {
         JsonOut jsout( fout );
         u.serialize_map_memory( jsout );
     }, _( "player map memory" ) );
@@ -3197,6 +3216,7 @@ spell_events &game::spell_events_subscriber()
 
 bool game::save()
 {
+    CATA_PROFILE_ZONE( "game::save" );
     std::chrono::seconds time_since_load =
         std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::steady_clock::now() - time_of_last_load );
@@ -4330,6 +4350,7 @@ void game::mon_info( const catacurses::window &w, int hor_padding )
 
 void game::mon_info_update( )
 {
+    CATA_PROFILE_ZONE( "game::mon_info_update" );
     int newseen = 0;
     const int safe_proxy_dist = get_option<int>( "SAFEMODEPROXIMITY" );
     const int iProxyDist = ( safe_proxy_dist <= 0 ) ? MAX_VIEW_DISTANCE :
@@ -4570,6 +4591,7 @@ void game::cleanup_dead()
 
 void game::monmove()
 {
+    CATA_PROFILE_ZONE( "game::monmove" );
     cleanup_dead();
 
     for( monster &critter : all_monsters() ) {
@@ -4652,6 +4674,8 @@ void game::monmove()
     }
 
     // Now, do active NPCs.
+    // Facts about the surroundings every NPC needs are shared while they move.
+    npc_perception::turn_scope perception_turn;
     for( npc &guy : g->all_npcs() ) {
         int turns = 0;
         if( guy.is_mounted() ) {
@@ -4696,6 +4720,7 @@ void game::monmove()
 
 void game::overmap_npc_move()
 {
+    CATA_PROFILE_ZONE( "game::overmap_npc_move" );
     std::vector<npc *> travelling_npcs;
     static constexpr int move_search_radius = 600;
     for( auto &elem : overmap_buffer.get_npcs_near_player( move_search_radius ) ) {
@@ -11575,6 +11600,10 @@ point game::update_map( int &x, int &y )
 
     // Update what parts of the world map we can see
     update_overmap_seen();
+    // Have the overmaps we are heading towards ready before we get there
+    overmap_buffer.prefetch_near( u.global_omt_location() );
+    m.prefetch_ahead( shift );
+    u.prepare_map_memory_region( m.getabs( u.pos() ) );
 
     return shift;
 }
@@ -45,6 +45,7 @@ static const std::string SAVE_MASTER( "master.gsav" );
 static const std::string SAVE_ARTIFACTS( "artifacts.gsav" );
 static const std::string SAVE_EXTENSION( ".sav" );
 static const std::string SAVE_EXTENSION_MAP_MEMORY( ".mm" );
+static const std::string SAVE_EXTENSION_MAP_MEMORY_REGIONS( ".mmr" );
 static const std::string SAVE_EXTENSION_LOG( ".log" );
 static const std::string SAVE_EXTENSION_WEATHER( ".weather" );
 static const std::string SAVE_EXTENSION_SHORTCUTS( ".shortcuts" );
@@ -111,6 +111,18 @@ const my_class &string_id<my_class>::obj() const
 template<typename T>
 class string_id_reader;
 
+/**
+ * Whether string id lookups on the calling thread may read and update the int id
+ * cached inside each `string_id`.  Those objects are often shared (static ids, ids in
+ * the game data), so work that runs off the main thread turns this off while it runs.
+ * Lookups then always go through the factory map, which is only read.
+ */
+inline bool &string_id_cache_enabled()
+{
+    static thread_local bool enabled = true;
+    return enabled;
+}
+
 template<typename T>
 class generic_factory
 {
@@ -144,6 +156,14 @@ class generic_factory
         const std::string legacy_id_member_name = "ident";
 
         bool find_id( const string_id<T> &id, int_id<T> &result ) const {
+            if( !string_id_cache_enabled() ) {
+                const auto iter = map.find( id );
+                if( iter == map.end() ) {
+                    return false;
+                }
+                result = iter->second;
+                return true;
+            }
             if( id._version == version ) {
                 result = int_id<T>( id._cid );
                 return is_valid( result );
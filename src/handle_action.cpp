@@ -68,6 +68,7 @@
 #include "panels.h"
 #include "player_activity.h"
 #include "popup.h"
+#include "profiler.h"
 #include "ranged.h"
 #include "rng.h"
 #include "safemode_ui.h"
@@ -1704,6 +1705,8 @@ bool game::handle_action()
         return false;
     }
 
+    // Only time the action itself, not the wait for the key that chose it.
+    CATA_PROFILE_ZONE( "game::handle_action" );
     // This has no action unless we're in a special game mode.
     gamemode->pre_action( act );
 
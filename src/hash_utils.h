@@ -2,7 +2,9 @@
 #ifndef CATA_SRC_HASH_UTILS_H
 #define CATA_SRC_HASH_UTILS_H
 
+#include <cstddef>
 #include <functional>
+#include <tuple>
 
 // Support for hashing standard types.
 // This is taken almost directly from the boost library code.
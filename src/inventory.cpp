@@ -940,21 +940,6 @@ std::vector<item *> inventory::active_items()
     return ret;
 }
 
-enchantment inventory::get_active_enchantment_cache( const Character &owner ) const
-{
-    enchantment temp_cache;
-    for( const std::list<item> &elem : items ) {
-        for( const item &check_item : elem ) {
-            for( const enchantment &ench : check_item.get_enchantments() ) {
-                if( ench.is_active( owner, check_item ) ) {
-                    temp_cache.force_add( ench );
-                }
-            }
-        }
-    }
-    return temp_cache;
-}
-
 int inventory::count_item( const itype_id &item_type ) const
 {
     int num = 0;
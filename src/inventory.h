@@ -225,9 +225,6 @@ class inventory : public visitable
 
         void copy_invlet_of( const inventory &other );
 
-        // gets a singular enchantment that is an amalgamation of all items that have active enchantments
-        enchantment get_active_enchantment_cache( const Character &owner ) const;
-
         int count_item( const itype_id &item_type ) const;
 
         book_proficiency_bonuses get_book_proficiency_bonuses() const;
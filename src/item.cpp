@@ -56,6 +56,7 @@
 #include "item_factory.h"
 #include "item_group.h"
 #include "item_pocket.h"
+#include "item_size_cache.h"
 #include "iteminfo_query.h"
 #include "itype.h"
 #include "iuse.h"
@@ -1130,72 +1131,48 @@ ret_val<bool> item::put_in( const item &payload, item_pocket::pocket_type pk_typ
 
 void item::set_var( const std::string &name, const int value )
 {
-    std::ostringstream tmpstream;
-    tmpstream.imbue( std::locale::classic() );
-    tmpstream << value;
-    item_vars[name] = tmpstream.str();
+    item_vars.set( name, static_cast<long long>( value ) );
 }
 
 void item::set_var( const std::string &name, const long long value )
 {
-    std::ostringstream tmpstream;
-    tmpstream.imbue( std::locale::classic() );
-    tmpstream << value;
-    item_vars[name] = tmpstream.str();
+    item_vars.set( name, value );
 }
 
 // NOLINTNEXTLINE(cata-no-long)
 void item::set_var( const std::string &name, const long value )
 {
-    std::ostringstream tmpstream;
-    tmpstream.imbue( std::locale::classic() );
-    tmpstream << value;
-    item_vars[name] = tmpstream.str();
+    item_vars.set( name, static_cast<long long>( value ) );
 }
 
 void item::set_var( const std::string &name, const double value )
 {
-    item_vars[name] = string_format( "%f", value );
+    item_vars.set( name, value );
 }
 
 double item::get_var( const std::string &name, const double default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
-        return default_value;
-    }
-    return atof( it->second.c_str() );
+    return item_vars.get( name, default_value );
 }
 
 void item::set_var( const std::string &name, const tripoint &value )
 {
-    item_vars[name] = string_format( "%d,%d,%d", value.x, value.y, value.z );
+    item_vars.set( name, value );
 }
 
 tripoint item::get_var( const std::string &name, const tripoint &default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
-        return default_value;
-    }
-    std::vector<std::string> values = string_split( it->second, ',' );
-    return tripoint( atoi( values[0].c_str() ),
-                     atoi( values[1].c_str() ),
-                     atoi( values[2].c_str() ) );
+    return item_vars.get( name, default_value );
 }
 
 void item::set_var( const std::string &name, const std::string &value )
 {
-    item_vars[name] = value;
+    item_vars.set( name, value );
 }
 
 std::string item::get_var( const std::string &name, const std::string &default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
-        return default_value;
-    }
-    return it->second;
+    return item_vars.get( name, default_value );
 }
 
 std::string item::get_var( const std::string &name ) const
@@ -1205,7 +1182,7 @@ std::string item::get_var( const std::string &name ) const
 
 bool item::has_var( const std::string &name ) const
 {
-    return item_vars.count( name ) > 0;
+    return item_vars.has( name );
 }
 
 void item::erase_var( const std::string &name )
@@ -1657,14 +1634,12 @@ void item::basic_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
 
     if( parts->test( iteminfo_parts::DESCRIPTION ) ) {
         insert_separation_line( info );
-        const std::map<std::string, std::string>::const_iterator idescription =
-            item_vars.find( "description" );
         const cata::optional<translation> snippet = SNIPPET.get_snippet_by_id( snip_id );
         if( snippet.has_value() ) {
             // Just use the dynamic description
             info.push_back( iteminfo( "DESCRIPTION", snippet.value().translated() ) );
-        } else if( idescription != item_vars.end() ) {
-            info.push_back( iteminfo( "DESCRIPTION", idescription->second ) );
+        } else if( has_var( "description" ) ) {
+            info.push_back( iteminfo( "DESCRIPTION", get_var( "description" ) ) );
         } else {
             if( has_flag( flag_MAGIC_FOCUS ) ) {
                 info.push_back( iteminfo( "DESCRIPTION",
@@ -1751,7 +1726,7 @@ void item::debug_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
             }, enumeration_conjunction::none );
 
             info.push_back( iteminfo( "BASE", string_format( _( "tags: %s" ), tags_listed ) ) );
-            for( auto const &imap : item_vars ) {
+            for( const std::pair<std::string, std::string> &imap : item_vars.as_strings() ) {
                 info.push_back( iteminfo( "BASE",
                                           string_format( _( "item var: %s, %s" ), imap.first,
                                                   imap.second ) ) );
@@ -4035,27 +4010,23 @@ void item::final_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
         }
     }
 
-    std::map<std::string, std::string>::const_iterator item_note = item_vars.find( "item_note" );
-
-    if( item_note != item_vars.end() && parts->test( iteminfo_parts::DESCRIPTION_NOTES ) ) {
+    if( has_var( "item_note" ) && parts->test( iteminfo_parts::DESCRIPTION_NOTES ) ) {
         insert_separation_line( info );
         std::string ntext;
-        std::map<std::string, std::string>::const_iterator item_note_tool =
-            item_vars.find( "item_note_tool" );
         const use_function *use_func =
-            item_note_tool != item_vars.end() ?
+            has_var( "item_note_tool" ) ?
             item_controller->find_template(
-                itype_id( item_note_tool->second ) )->get_use( "inscribe" ) :
+                itype_id( get_var( "item_note_tool" ) ) )->get_use( "inscribe" ) :
             nullptr;
         const inscribe_actor *use_actor =
             use_func ? dynamic_cast<const inscribe_actor *>( use_func->get_actor_ptr() ) : nullptr;
         if( use_actor ) {
             //~ %1$s: gerund (e.g. carved), %2$s: item name, %3$s: inscription text
             ntext = string_format( pgettext( "carving", "%1$s on the %2$s is: %3$s" ),
-                                   use_actor->gerund, tname(), item_note->second );
+                                   use_actor->gerund, tname(), get_var( "item_note" ) );
         } else {
             //~ %1$s: inscription text
-            ntext = string_format( pgettext( "carving", "Note: %1$s" ), item_note->second );
+            ntext = string_format( pgettext( "carving", "Note: %1$s" ), get_var( "item_note" ) );
         }
         info.push_back( iteminfo( "DESCRIPTION", ntext ) );
     }
@@ -4524,6 +4495,7 @@ int item::on_wield_cost( const player &p ) const
 
 void item::on_wield( player &p )
 {
+    p.invalidate_enchantment_cache();
     int wield_cost = on_wield_cost( p );
     p.moves -= wield_cost;
 
@@ -4693,7 +4665,7 @@ std::string item::tname( unsigned int quantity, bool with_prefix, unsigned int t
     std::string maintext;
     std::string contents_suffix_text;
 
-    if( is_corpse() || typeId() == itype_blood || item_vars.find( "name" ) != item_vars.end() ) {
+    if( is_corpse() || typeId() == itype_blood || has_var( "name" ) ) {
         maintext = type_name( quantity );
     } else if( is_gun() || is_tool() || is_magazine() ) {
         int amt = 0;
@@ -4880,7 +4852,7 @@ std::string item::tname( unsigned int quantity, bool with_prefix, unsigned int t
         ret = utf8_truncate( ret, truncate + truncate_override );
     }
 
-    if( item_vars.find( "item_note" ) != item_vars.end() ) {
+    if( has_var( "item_note" ) ) {
         //~ %s is an item name. This style is used to denote items with notes.
         return string_format( _( "*%s*" ), ret );
     } else {
@@ -5074,6 +5046,22 @@ int item::price( bool practical ) const
 
 // TODO: MATERIALS add a density field to materials.json
 units::mass item::weight( bool, bool integral ) const
+{
+    if( !item_size_cache::can_cache( *this ) ) {
+        return calc_weight( integral );
+    }
+    if( const units::mass *cached = item_size_cache::find_weight( *this, integral ) ) {
+        if( debug_mode && *cached != calc_weight( integral ) ) {
+            debugmsg( "cached weight of %s is out of date", tname() );
+        }
+        return *cached;
+    }
+    const units::mass ret = calc_weight( integral );
+    item_size_cache::store_weight( *this, integral, ret );
+    return ret;
+}
+
+units::mass item::calc_weight( bool integral ) const
 {
     if( is_null() ) {
         return 0_gram;
@@ -5301,6 +5289,23 @@ units::volume item::base_volume() const
 }
 
 units::volume item::volume( bool integral, bool ignore_contents ) const
+{
+    if( !item_size_cache::can_cache( *this ) ) {
+        return calc_volume( integral, ignore_contents );
+    }
+    if( const units::volume *cached = item_size_cache::find_volume( *this, integral,
+                                      ignore_contents ) ) {
+        if( debug_mode && *cached != calc_volume( integral, ignore_contents ) ) {
+            debugmsg( "cached volume of %s is out of date", tname() );
+        }
+        return *cached;
+    }
+    const units::volume ret = calc_volume( integral, ignore_contents );
+    item_size_cache::store_volume( *this, integral, ignore_contents, ret );
+    return ret;
+}
+
+units::volume item::calc_volume( bool integral, bool ignore_contents ) const
 {
     if( is_null() ) {
         return 0_ml;
@@ -5490,6 +5495,7 @@ int item::current_reach_range( const Character &guy ) const
 void item::unset_flags()
 {
     item_tags.clear();
+    item_tag_bits.clear();
     requires_tags_processing = true;
 }
 
@@ -5510,18 +5516,25 @@ bool item::has_fault_flag( const std::string &searched_flag ) const
 
 bool item::has_own_flag( const flag_id &f ) const
 {
-    return item_tags.count( f );
+    return item_tag_bits.test( f );
 }
 
 bool item::has_flag( const flag_id &f ) const
 {
-    bool ret = false;
-    if( !f.is_valid() ) {
+    // resolved once (and cached in f) for all the bitsets below
+    const int bit = flag_bitset::bit_of( f );
+    if( bit < 0 ) {
         debugmsg( "Attempted to check invalid flag_id %s", f.str() );
         return false;
     }
 
-    if( f->inherit() ) {
+    // item type and item specific flags first, they are just a bit test
+    if( type->has_flag( f, bit ) || item_tag_bits.test( bit ) ) {
+        return true;
+    }
+
+    // only guns and tools can have mods, don't bother collecting them for anything else
+    if( ( is_gun() || is_tool() ) && f->inherit() ) {
         for( const item *e : is_gun() ? gunmods() : toolmods() ) {
             // gunmods fired separately do not contribute to base gun flags
             if( !e->is_gun() && e->has_flag( f ) ) {
@@ -5530,21 +5543,14 @@ bool item::has_flag( const flag_id &f ) const
         }
     }
 
-    // other item type flags
-    ret = type->has_flag( f );
-    if( ret ) {
-        return ret;
-    }
-
-    // now check for item specific flags
-    ret = has_own_flag( f );
-    return ret;
+    return false;
 }
 
 item &item::set_flag( const flag_id &flag )
 {
     if( flag.is_valid() ) {
         item_tags.insert( flag );
+        item_tag_bits.set( flag );
         requires_tags_processing = true;
     } else {
         debugmsg( "Attempted to set invalid flag_id %s", flag.str() );
@@ -5555,6 +5561,7 @@ item &item::set_flag( const flag_id &flag )
 item &item::unset_flag( const flag_id &flag )
 {
     item_tags.erase( flag );
+    item_tag_bits.reset( flag );
     requires_tags_processing = true;
     return *this;
 }
@@ -9226,26 +9233,26 @@ bool item_compare_by_charges( const item &left, const item &right )
 static const std::string USED_BY_IDS( "USED_BY_IDS" );
 bool item::already_used_by_player( const Character &p ) const
 {
-    const auto it = item_vars.find( USED_BY_IDS );
-    if( it == item_vars.end() ) {
+    if( !has_var( USED_BY_IDS ) ) {
         return false;
     }
     // USED_BY_IDS always starts *and* ends with a ';', the search string
     // ';<id>;' matches at most one part of USED_BY_IDS, and only when exactly that
     // id has been added.
     const std::string needle = string_format( ";%d;", p.getID().get_value() );
-    return it->second.find( needle ) != std::string::npos;
+    return get_var( USED_BY_IDS ).find( needle ) != std::string::npos;
 }
 
 void item::mark_as_used_by_player( const player &p )
 {
-    std::string &used_by_ids = item_vars[ USED_BY_IDS ];
+    std::string used_by_ids = get_var( USED_BY_IDS );
     if( used_by_ids.empty() ) {
         // *always* start with a ';'
         used_by_ids = ";";
     }
     // and always end with a ';'
     used_by_ids += string_format( "%d;", p.getID().get_value() );
+    set_var( USED_BY_IDS, used_by_ids );
 }
 
 bool item::can_holster( const item &obj, bool ) const
@@ -9732,6 +9739,7 @@ void item::overwrite_relic( const relic &nrelic )
 
 bool item::use_relic( Character &guy, const tripoint &pos )
 {
+    guy.invalidate_enchantment_cache();
     return relic_data->activate( guy, pos );
 }
 
@@ -10392,7 +10400,6 @@ bool item::is_reloadable() const
 
 std::string item::type_name( unsigned int quantity ) const
 {
-    const auto iter = item_vars.find( "name" );
     std::string ret_name;
     if( typeId() == itype_blood ) {
         if( corpse == nullptr || corpse->id.is_null() ) {
@@ -10402,8 +10409,8 @@ std::string item::type_name( unsigned int quantity ) const
                                              "%s blood",  quantity ),
                                   corpse->nname() );
         }
-    } else if( iter != item_vars.end() ) {
-        return iter->second;
+    } else if( has_var( "name" ) ) {
+        return get_var( "name" );
     } else {
         ret_name = type->nname( quantity );
     }
@@ -10423,7 +10430,7 @@ std::string item::type_name( unsigned int quantity ) const
         };
         switch( cname.type ) {
             case condition_type::FLAG:
-                if( has_flag( flag_id( cname.condition ) ) ) {
+                if( has_flag( cname.flag ) ) {
                     ret_name = string_format( cname.name.translated( quantity ), ret_name );
                 }
                 break;
@@ -19,11 +19,13 @@
 #include "cata_utility.h"
 #include "craft_command.h"
 #include "enums.h"
+#include "flag_bitset.h"
 #include "gun_mode.h"
 #include "io_tags.h"
 #include "item_contents.h"
 #include "item_location.h"
 #include "item_pocket.h"
+#include "item_var_map.h"
 #include "material.h"
 #include "optional.h"
 #include "requirements.h"
@@ -2291,9 +2293,11 @@ class item : public visitable
          */
         bool requires_tags_processing = true;
         FlagsSetType item_tags; // generic item specific flags
+        // same flags as item_tags, for has_flag, kept in sync with it by set_flag and friends
+        flag_bitset item_tag_bits;
         safe_reference_anchor anchor;
         const itype *curammo = nullptr;
-        std::map<std::string, std::string> item_vars;
+        item_var_map item_vars;
         const mtype *corpse = nullptr;
         std::string corpse_name;       // Name of the late lamented
         std::set<matec_id> techniques; // item specific techniques
@@ -2347,6 +2351,10 @@ class item : public visitable
         bool encumbrance_update_ = false;
 
     private:
+        /** @ref weight and @ref volume, bypassing item_size_cache */
+        units::mass calc_weight( bool integral ) const;
+        units::volume calc_volume( bool integral, bool ignore_contents ) const;
+
         /**
          * Accumulated rot, expressed as time the item has been in standard temperature.
          * It is compared to shelf life (@ref islot_comestible::spoils) to decide if
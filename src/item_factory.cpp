@@ -537,6 +537,7 @@ void Item_factory::finalize_post( itype &obj )
         }
         return false;
     } );
+    obj.item_tag_bits.assign( obj.item_tags );
 
     // handle complex firearms as a special case
     if( obj.gun && !obj.has_flag( flag_PRIMITIVE_RANGED_WEAPON ) ) {
@@ -3064,6 +3065,9 @@ void Item_factory::load_basic_info( const JsonObject &jo, itype &def, const std:
             conditional_name cname;
             cname.type = curr.get_enum_value<condition_type>( "type" );
             cname.condition = curr.get_string( "condition" );
+            if( cname.type == condition_type::FLAG ) {
+                cname.flag = flag_id( cname.condition );
+            }
             cname.name = translation( translation::plural_tag() );
             if( !curr.read( "name", cname.name ) ) {
                 curr.throw_error( "name unspecified for conditional name" );
@@ -0,0 +1,101 @@
+#include "item_size_cache.h"
+
+#include <unordered_map>
+
+#include "item.h"
+#include "optional.h"
+
+namespace
+{
+struct cache_entry {
+    // the address of a temporary item may be reused by another one, check it is still the same
+    const itype *type = nullptr;
+    int charges = 0;
+    cata::optional<units::mass> weight[2];
+    cata::optional<units::volume> volume[4];
+};
+
+struct size_cache {
+    int depth = 0;
+    std::unordered_map<const item *, cache_entry> entries;
+};
+} // namespace
+
+static size_cache &get_size_cache()
+{
+    // weight and volume may be asked for on other threads, each gets its own cache
+    static thread_local size_cache cache;
+    return cache;
+}
+
+item_size_cache::scope::scope()
+{
+    ++get_size_cache().depth;
+}
+
+item_size_cache::scope::~scope()
+{
+    size_cache &cache = get_size_cache();
+    if( --cache.depth == 0 ) {
+        cache.entries.clear();
+    }
+}
+
+bool item_size_cache::can_cache( const item &it )
+{
+    return get_size_cache().depth > 0 && !it.contents.empty();
+}
+
+static cache_entry *find_entry( const item &it )
+{
+    size_cache &cache = get_size_cache();
+    const auto iter = cache.entries.find( &it );
+    if( iter == cache.entries.end() || iter->second.type != it.type ||
+        iter->second.charges != it.charges ) {
+        return nullptr;
+    }
+    return &iter->second;
+}
+
+static cache_entry &entry_for( const item &it )
+{
+    cache_entry &entry = get_size_cache().entries[&it];
+    if( entry.type != it.type || entry.charges != it.charges ) {
+        entry = cache_entry();
+        entry.type = it.type;
+        entry.charges = it.charges;
+    }
+    return entry;
+}
+
+const units::mass *item_size_cache::find_weight( const item &it, const bool integral )
+{
+    cache_entry *entry = find_entry( it );
+    if( entry == nullptr || !entry->weight[integral] ) {
+        return nullptr;
+    }
+    return &*entry->weight[integral];
+}
+
+void item_size_cache::store_weight( const item &it, const bool integral,
+                                    const units::mass &weight )
+{
+    entry_for( it ).weight[integral] = weight;
+}
+
+const units::volume *item_size_cache::find_volume( const item &it, const bool integral,
+        const bool ignore_contents )
+{
+    cache_entry *entry = find_entry( it );
+    const int index = integral * 2 + ignore_contents;
+    if( entry == nullptr || !entry->volume[index] ) {
+        return nullptr;
+    }
+    return &*entry->volume[index];
+}
+
+void item_size_cache::store_volume( const item &it, const bool integral,
+                                    const bool ignore_contents, const units::volume &volume )
+{
+    entry_for( it ).volume[integral * 2 + ignore_contents] = volume;
+}
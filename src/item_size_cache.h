@@ -0,0 +1,46 @@
+#pragma once
+#ifndef CATA_SRC_ITEM_SIZE_CACHE_H
+#define CATA_SRC_ITEM_SIZE_CACHE_H
+
+#include "units.h"
+
+class item;
+
+/**
+ * Memoises item::weight and item::volume of containers while a scope is alive.
+ *
+ * Both recurse through every pocket of every contained item, and code looking for a
+ * pocket to put something in or adding up what a character carries asks about the same
+ * containers over and over.  Items keep no link to their container and their charges and
+ * contents are changed in place all over the code, so a change deep inside a container
+ * can not invalidate cached values of its parents.  Values are therefore only reused
+ * inside a @ref scope, which callers open around code that does not change any item.
+ * Scopes nest, the cache is emptied when the outermost one ends.
+ *
+ * Only items with contents are cached, the others are cheap to compute.  In debug mode
+ * every reused value is checked against a fresh computation.
+ */
+class item_size_cache
+{
+    public:
+        class scope
+        {
+            public:
+                scope();
+                ~scope();
+
+                scope( const scope & ) = delete;
+                scope &operator=( const scope & ) = delete;
+        };
+
+        /** Whether @p it's values may be cached now. */
+        static bool can_cache( const item &it );
+
+        static const units::mass *find_weight( const item &it, bool integral );
+        static void store_weight( const item &it, bool integral, const units::mass &weight );
+        static const units::volume *find_volume( const item &it, bool integral, bool ignore_contents );
+        static void store_volume( const item &it, bool integral, bool ignore_contents,
+                                  const units::volume &volume );
+};
+
+#endif // CATA_SRC_ITEM_SIZE_CACHE_H
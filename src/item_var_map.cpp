@@ -0,0 +1,268 @@
+#include "item_var_map.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <unordered_map>
+
+#include "json.h"
+#include "output.h"
+#include "string_formatter.h"
+
+namespace
+{
+struct var_names {
+    std::vector<std::string> names;
+    std::unordered_map<std::string, int> keys;
+};
+} // namespace
+
+static var_names &get_var_names()
+{
+    static var_names names;
+    return names;
+}
+
+int item_var_map::find_key( const std::string &name )
+{
+    const var_names &names = get_var_names();
+    const auto iter = names.keys.find( name );
+    return iter == names.keys.end() ? -1 : iter->second;
+}
+
+int item_var_map::intern( const std::string &name )
+{
+    var_names &names = get_var_names();
+    const auto iter = names.keys.emplace( name, static_cast<int>( names.names.size() ) );
+    if( iter.second ) {
+        names.names.push_back( name );
+    }
+    return iter.first->second;
+}
+
+const std::string &item_var_map::key_name( const int key )
+{
+    return get_var_names().names[key];
+}
+
+std::string item_var_map::var::to_string() const
+{
+    switch( type ) {
+        case var_type::integer:
+            return std::to_string( integer );
+        case var_type::number:
+            return string_format( "%f", number );
+        case var_type::point:
+            return string_format( "%d,%d,%d", point.x, point.y, point.z );
+        case var_type::text:
+            break;
+    }
+    return text;
+}
+
+bool item_var_map::var::same_value( const var &rhs ) const
+{
+    if( type != rhs.type ) {
+        return to_string() == rhs.to_string();
+    }
+    switch( type ) {
+        case var_type::integer:
+            return integer == rhs.integer;
+        case var_type::number:
+            return number == rhs.number;
+        case var_type::point:
+            return point == rhs.point;
+        case var_type::text:
+            break;
+    }
+    return text == rhs.text;
+}
+
+const item_var_map::var *item_var_map::find( const std::string &name ) const
+{
+    const int key = find_key( name );
+    if( key < 0 ) {
+        return nullptr;
+    }
+    for( const var &v : vars ) {
+        if( v.key == key ) {
+            return &v;
+        }
+    }
+    return nullptr;
+}
+
+item_var_map::var &item_var_map::get_or_add( const std::string &name )
+{
+    const int key = intern( name );
+    for( var &v : vars ) {
+        if( v.key == key ) {
+            v.text.clear();
+            return v;
+        }
+    }
+    vars.emplace_back();
+    vars.back().key = key;
+    return vars.back();
+}
+
+void item_var_map::set( const std::string &name, const long long value )
+{
+    var &v = get_or_add( name );
+    v.type = var_type::integer;
+    v.integer = value;
+}
+
+void item_var_map::set( const std::string &name, const double value )
+{
+    var &v = get_or_add( name );
+    v.type = var_type::number;
+    // keep the precision the value has in the save file, so it does not change on reload
+    v.number = atof( string_format( "%f", value ).c_str() );
+}
+
+void item_var_map::set( const std::string &name, const tripoint &value )
+{
+    var &v = get_or_add( name );
+    v.type = var_type::point;
+    v.point = value;
+}
+
+void item_var_map::set( const std::string &name, const std::string &value )
+{
+    var &v = get_or_add( name );
+    v.type = var_type::text;
+    v.text = value;
+}
+
+void item_var_map::set_from_string( const std::string &name, const std::string &value )
+{
+    if( !value.empty() ) {
+        errno = 0;
+        char *end = nullptr;
+        const long long integer = strtoll( value.c_str(), &end, 10 );
+        if( errno == 0 && *end == '\0' && std::to_string( integer ) == value ) {
+            set( name, integer );
+            return;
+        }
+        const double number = atof( value.c_str() );
+        if( value.find( '.' ) != std::string::npos && string_format( "%f", number ) == value ) {
+            set( name, number );
+            return;
+        }
+        if( std::count( value.begin(), value.end(), ',' ) == 2 ) {
+            const std::vector<std::string> values = string_split( value, ',' );
+            const tripoint p( atoi( values[0].c_str() ), atoi( values[1].c_str() ),
+                              atoi( values[2].c_str() ) );
+            if( string_format( "%d,%d,%d", p.x, p.y, p.z ) == value ) {
+                set( name, p );
+                return;
+            }
+        }
+    }
+    set( name, value );
+}
+
+double item_var_map::get( const std::string &name, const double default_value ) const
+{
+    const var *v = find( name );
+    if( v == nullptr ) {
+        return default_value;
+    }
+    switch( v->type ) {
+        case var_type::integer:
+            return static_cast<double>( v->integer );
+        case var_type::number:
+            return v->number;
+        case var_type::point:
+        case var_type::text:
+            break;
+    }
+    return atof( v->to_string().c_str() );
+}
+
+tripoint item_var_map::get( const std::string &name, const tripoint &default_value ) const
+{
+    const var *v = find( name );
+    if( v == nullptr ) {
+        return default_value;
+    }
+    if( v->type == var_type::point ) {
+        return v->point;
+    }
+    const std::vector<std::string> values = string_split( v->to_string(), ',' );
+    if( values.size() < 3 ) {
+        return default_value;
+    }
+    return tripoint( atoi( values[0].c_str() ),
+                     atoi( values[1].c_str() ),
+                     atoi( values[2].c_str() ) );
+}
+
+std::string item_var_map::get( const std::string &name, const std::string &default_value ) const
+{
+    const var *v = find( name );
+    if( v == nullptr ) {
+        return default_value;
+    }
+    return v->to_string();
+}
+
+bool item_var_map::has( const std::string &name ) const
+{
+    return find( name ) != nullptr;
+}
+
+void item_var_map::erase( const std::string &name )
+{
+    const int key = find_key( name );
+    vars.erase( std::remove_if( vars.begin(), vars.end(), [key]( const var & v ) {
+        return v.key == key;
+    } ), vars.end() );
+}
+
+std::vector<std::pair<std::string, std::string>> item_var_map::as_strings() const
+{
+    std::vector<std::pair<std::string, std::string>> ret;
+    ret.reserve( vars.size() );
+    for( const var &v : vars ) {
+        ret.emplace_back( key_name( v.key ), v.to_string() );
+    }
+    std::sort( ret.begin(), ret.end() );
+    return ret;
+}
+
+bool item_var_map::operator==( const item_var_map &rhs ) const
+{
+    if( vars.size() != rhs.vars.size() ) {
+        return false;
+    }
+    for( const var &v : vars ) {
+        const auto other = std::find_if( rhs.vars.begin(), rhs.vars.end(), [&v]( const var & o ) {
+            return o.key == v.key;
+        } );
+        if( other == rhs.vars.end() || !v.same_value( *other ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void item_var_map::serialize( JsonOut &jsout ) const
+{
+    jsout.start_object();
+    for( const std::pair<std::string, std::string> &v : as_strings() ) {
+        jsout.member( v.first, v.second );
+    }
+    jsout.end_object();
+}
+
+void item_var_map::deserialize( JsonIn &jsin )
+{
+    clear();
+    jsin.start_object();
+    while( !jsin.end_object() ) {
+        const std::string name = jsin.get_member_name();
+        set_from_string( name, jsin.get_string() );
+    }
+}
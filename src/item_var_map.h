@@ -0,0 +1,104 @@
+#pragma once
+#ifndef CATA_SRC_ITEM_VAR_MAP_H
+#define CATA_SRC_ITEM_VAR_MAP_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "point.h"
+
+class JsonIn;
+class JsonOut;
+
+/**
+ * Storage of the item variables (see item::set_var).
+ *
+ * Variable names are interned into small integer keys shared by all items, and values keep
+ * the type they were set with, so reading a number back does not parse a string.  An item
+ * rarely has more than a handful of variables, they are kept in a plain vector.
+ *
+ * Every value has a string form, the one the old string map stored: that is what is saved,
+ * what is returned when a value is read as a different type than it was set with, and what
+ * values are compared by.  Values loaded from a save are stored with the type their string
+ * form was written from, so the save format is the same as before.
+ */
+class item_var_map
+{
+    public:
+        void set( const std::string &name, long long value );
+        void set( const std::string &name, double value );
+        void set( const std::string &name, const tripoint &value );
+        void set( const std::string &name, const std::string &value );
+
+        double get( const std::string &name, double default_value ) const;
+        tripoint get( const std::string &name, const tripoint &default_value ) const;
+        std::string get( const std::string &name, const std::string &default_value ) const;
+
+        bool has( const std::string &name ) const;
+        void erase( const std::string &name );
+        /** Erases all variables whose name @p pred returns true for. */
+        template<typename Pred>
+        void erase_if( Pred pred ) {
+            for( auto it = vars.begin(); it != vars.end(); ) {
+                if( pred( key_name( it->key ) ) ) {
+                    it = vars.erase( it );
+                } else {
+                    ++it;
+                }
+            }
+        }
+        void clear() {
+            vars.clear();
+        }
+        bool empty() const {
+            return vars.empty();
+        }
+
+        /** All variables as name / string form pairs, sorted by name. */
+        std::vector<std::pair<std::string, std::string>> as_strings() const;
+
+        bool operator==( const item_var_map &rhs ) const;
+        bool operator!=( const item_var_map &rhs ) const {
+            return !operator==( rhs );
+        }
+
+        void serialize( JsonOut &jsout ) const;
+        void deserialize( JsonIn &jsin );
+
+    private:
+        enum class var_type : char {
+            integer,
+            number,
+            point,
+            text
+        };
+
+        struct var {
+            int key = 0;
+            var_type type = var_type::text;
+            union {
+                long long integer;
+                double number;
+            };
+            tripoint point;
+            std::string text;
+
+            var() : integer( 0 ) {}
+            std::string to_string() const;
+            bool same_value( const var &rhs ) const;
+        };
+
+        static int find_key( const std::string &name );
+        static int intern( const std::string &name );
+        static const std::string &key_name( int key );
+
+        const var *find( const std::string &name ) const;
+        var &get_or_add( const std::string &name );
+        /** Stores @p value with the type its string form was written from. */
+        void set_from_string( const std::string &name, const std::string &value );
+
+        std::vector<var> vars;
+};
+
+#endif // CATA_SRC_ITEM_VAR_MAP_H
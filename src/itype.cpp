@@ -73,7 +73,15 @@ bool itype::has_use() const
 
 bool itype::has_flag( const flag_id &flag ) const
 {
-    return item_tags.count( flag );
+    return has_flag( flag, flag_bitset::bit_of( flag ) );
+}
+
+bool itype::has_flag( const flag_id &flag, const int bit ) const
+{
+    if( item_tag_bits.empty() ) {
+        return item_tags.count( flag );
+    }
+    return item_tag_bits.test( bit );
 }
 
 const itype::FlagsSetType &itype::get_flags() const
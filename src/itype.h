@@ -18,6 +18,7 @@
 #include "damage.h"
 #include "enums.h" // point
 #include "explosion.h"
+#include "flag_bitset.h"
 #include "game_constants.h"
 #include "item_pocket.h"
 #include "iuse.h" // use_function
@@ -816,6 +817,8 @@ struct conditional_name {
     condition_type type;
     // Context name  (i.e. "CANNIBALISM"   or "mutant")
     std::string condition;
+    // The condition as a flag, for FLAG conditions, so it is not looked up on every call
+    flag_id flag;
     // Name to apply (i.e. "Luigi lasagne" or "smoked mutant"). Can use %s which will
     // be replaced by the item's normal name and/or preceding conditional names.
     translation name;
@@ -1026,6 +1029,11 @@ struct itype {
         /// @}
 
         FlagsSetType item_tags;
+        /**
+         * Same flags as @ref item_tags, for fast lookups. Built in Item_factory::finalize_post,
+         * until then @ref has_flag falls back to looking at item_tags.
+         */
+        flag_bitset item_tag_bits;
 
     protected:
         itype_id id = itype_id::NULL_ID(); /** unique string identifier for this type */
@@ -1118,6 +1126,8 @@ struct itype {
         bool has_use() const;
 
         bool has_flag( const flag_id &flag ) const;
+        /** Same as above, @p bit is flag_bitset::bit_of( flag ) for callers that already have it. */
+        bool has_flag( const flag_id &flag, int bit ) const;
 
         // returns read-only set of all item tags/flags
         const FlagsSetType &get_flags() const;
@@ -120,12 +120,17 @@ void kill_tracker::notify( const cata::event &e )
 {
     switch( e.type() ) {
         case event_type::character_kills_monster: {
-            character_id killer = e.get<character_id>( "killer" );
+            using cata::event;
+            constexpr size_t killer_field =
+                event::field_index<event_type::character_kills_monster>( "killer" );
+            constexpr size_t victim_type_field =
+                event::field_index<event_type::character_kills_monster>( "victim_type" );
+            character_id killer = e.get<character_id>( killer_field );
             if( killer != get_player_character().getID() ) {
                 // TODO: add a kill counter for npcs?
                 break;
             }
-            mtype_id victim_type = e.get<mtype_id>( "victim_type" );
+            mtype_id victim_type = e.get<mtype_id>( victim_type_field );
             kills[victim_type]++;
             break;
         }
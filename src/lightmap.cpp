@@ -35,6 +35,7 @@
 #include "npc.h"
 #include "optional.h"
 #include "point.h"
+#include "profiler.h"
 #include "string_formatter.h"
 #include "submap.h"
 #include "tileray.h"
@@ -86,6 +87,7 @@ void map::add_light_from_items( const tripoint &p, const item_stack::iterator &b
 // TODO: Consider making this just clear the cache and dynamically fill it in as is_transparent() is called
 bool map::build_transparency_cache( const int zlev )
 {
+    CATA_PROFILE_ZONE( "map::build_transparency_cache" );
     auto &map_cache = get_cache( zlev );
     auto &transparent_cache_wo_fields = map_cache.transparent_cache_wo_fields;
     auto &transparency_cache = map_cache.transparency_cache;
@@ -185,11 +187,13 @@ bool map::build_transparency_cache( const int zlev )
         }
     }
     map_cache.transparency_cache_dirty.reset();
+    invalidate_los_cache();
     return true;
 }
 
 bool map::build_vision_transparency_cache( const int zlev )
 {
+    CATA_PROFILE_ZONE( "map::build_vision_transparency_cache" );
     auto &map_cache = get_cache( zlev );
     auto &transparency_cache = map_cache.transparency_cache;
     auto &vision_transparency_cache = map_cache.vision_transparency_cache;
@@ -392,6 +396,7 @@ void map::build_sunlight_cache( int pzlev )
 
 void map::generate_lightmap( const int zlev )
 {
+    CATA_PROFILE_ZONE( "map::generate_lightmap" );
     auto &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
     auto &sm = map_cache.sm;
@@ -981,6 +986,7 @@ castLightAll<fragment_cloud, fragment_cloud, shrapnel_calc, shrapnel_check,
  */
 void map::build_seen_cache( const tripoint &origin, const int target_z )
 {
+    CATA_PROFILE_ZONE( "map::build_seen_cache" );
     auto &map_cache = get_cache( target_z );
     float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.vision_transparency_cache;
     float ( &seen_cache )[MAPSIZE_X][MAPSIZE_Y] = map_cache.seen_cache;
@@ -0,0 +1,69 @@
+#include "los_cache.h"
+
+#include "game_constants.h"
+#include "point.h"
+
+// 2^16 entries of 16 bytes each, enough to hold every monster/target pair of
+// a crowded reality bubble.
+static constexpr int los_cache_bits = 16;
+static constexpr int coord_bits = 12;
+static constexpr int z_bits = 6;
+
+static_assert( MAPSIZE_X <= ( 1 << coord_bits ) && MAPSIZE_Y <= ( 1 << coord_bits ),
+               "map is too large to pack its coordinates into los_cache keys" );
+static_assert( OVERMAP_LAYERS <= ( 1 << z_bits ),
+               "too many z-levels to pack into los_cache keys" );
+
+bool los_cache::can_cache( const tripoint &p )
+{
+    return p.x >= 0 && p.y >= 0 && p.x < MAPSIZE_X && p.y < MAPSIZE_Y &&
+           p.z >= -OVERMAP_DEPTH && p.z <= OVERMAP_HEIGHT;
+}
+
+static uint64_t pack( const tripoint &p )
+{
+    return static_cast<uint64_t>( p.x ) << ( coord_bits + z_bits ) |
+           static_cast<uint64_t>( p.y ) << z_bits |
+           static_cast<uint64_t>( p.z + OVERMAP_DEPTH );
+}
+
+uint64_t los_cache::make_key( const tripoint &a, const tripoint &b )
+{
+    // Canonicalize the order of the points so the cache is reflexive.
+    const uint64_t pa = pack( a );
+    const uint64_t pb = pack( b );
+    constexpr int point_bits = 2 * coord_bits + z_bits;
+    return pa < pb ? pa << point_bits | pb : pb << point_bits | pa;
+}
+
+size_t los_cache::slot( uint64_t key ) const
+{
+    // Fibonacci hashing, keeps the top bits of the product.
+    return static_cast<size_t>( ( key * 0x9E3779B97F4A7C15ull ) >> ( 64 - los_cache_bits ) );
+}
+
+int los_cache::get( const tripoint &a, const tripoint &b, uint32_t generation ) const
+{
+    if( entries.empty() ) {
+        return -1;
+    }
+    const uint64_t key = make_key( a, b );
+    const entry &e = entries[slot( key )];
+    if( e.generation != generation || e.key != key ) {
+        return -1;
+    }
+    return e.visible ? 1 : 0;
+}
+
+void los_cache::set( const tripoint &a, const tripoint &b, uint32_t generation, bool visible )
+{
+    if( entries.empty() ) {
+        // Allocated on first use, most maps (e.g. mapgen's tinymaps) never trace a line.
+        entries.resize( static_cast<size_t>( 1 ) << los_cache_bits );
+    }
+    const uint64_t key = make_key( a, b );
+    entry &e = entries[slot( key )];
+    e.key = key;
+    e.generation = generation;
+    e.visible = visible;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#ifndef CATA_SRC_LOS_CACHE_H
+#define CATA_SRC_LOS_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct tripoint;
+
+/**
+ * Memoises line of sight results between pairs of map squares.
+ *
+ * Every entry is tagged with the generation of the map's line of sight
+ * inputs (see map::invalidate_los_cache), so a change anywhere on the map
+ * invalidates the whole cache with a single counter increment and there is
+ * nothing to clear.
+ *
+ * The cache is direct mapped: pairs hashing to the same slot overwrite each
+ * other instead of chaining.  Lookups are a single probe and nothing is
+ * allocated after the first insertion.
+ *
+ * Pairs are stored unordered, i.e. the cache assumes (a, b) and (b, a) have the
+ * same answer, like map::sees always has.
+ */
+class los_cache
+{
+    public:
+        /** Whether @p p can be packed into a key. Anything inside the map can. */
+        static bool can_cache( const tripoint &p );
+
+        /** Returns -1 if the pair is not cached, 0 if not visible and 1 if visible. */
+        int get( const tripoint &a, const tripoint &b, uint32_t generation ) const;
+        void set( const tripoint &a, const tripoint &b, uint32_t generation, bool visible );
+
+    private:
+        struct entry {
+            uint64_t key = 0;
+            // 0 is never a valid generation, so fresh entries are misses
+            uint32_t generation = 0;
+            bool visible = false;
+        };
+
+        static uint64_t make_key( const tripoint &a, const tripoint &b );
+        size_t slot( uint64_t key ) const;
+
+        std::vector<entry> entries;
+};
+
+#endif // CATA_SRC_LOS_CACHE_H
@@ -11,8 +11,6 @@
 #include "enums.h" // IWYU pragma: keep
 #include "point.h"
 
-struct memorized_terrain_tile;
-
 template<typename Key, typename Value>
 class lru_cache
 {
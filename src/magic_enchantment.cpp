@@ -148,7 +148,7 @@ void enchantment::load_enchantment( const JsonObject &jo, const std::string &src
 
 bool enchantment::is_active( const Character &guy, const item &parent ) const
 {
-    if( !guy.has_item( parent ) ) {
+    if( !is_carried_right( guy, parent ) ) {
         return false;
     }
 
@@ -157,13 +157,23 @@ bool enchantment::is_active( const Character &guy, const item &parent ) const
         return true;
     }
 
-    if( !( active_conditions.first == has::HELD ||
-           ( active_conditions.first == has::WIELD && guy.is_wielding( parent ) ) ||
-           ( active_conditions.first == has::WORN && guy.is_worn( parent ) ) ) ) {
+    return is_active( guy, parent.active );
+}
+
+bool enchantment::is_carried_right( const Character &guy, const item &parent ) const
+{
+    if( !guy.has_item( parent ) ) {
         return false;
     }
+    return active_conditions.first == has::HELD ||
+           ( active_conditions.first == has::WIELD && guy.is_wielding( parent ) ) ||
+           ( active_conditions.first == has::WORN && guy.is_worn( parent ) );
+}
 
-    return is_active( guy, parent.active );
+bool enchantment::depends_on_location() const
+{
+    return active_conditions.second == condition::UNDERGROUND ||
+           active_conditions.second == condition::UNDERWATER;
 }
 
 bool enchantment::is_active( const Character &guy, const bool active ) const
@@ -150,6 +150,12 @@ class enchantment
         // @active means the container for the enchantment is active, for comparison to active flag.
         bool is_active( const Character &guy, bool active ) const;
 
+        // @parent is held by guy in the way this enchantment requires (held, wielded or worn)
+        bool is_carried_right( const Character &guy, const item &parent ) const;
+
+        // whether the condition depends on where the Character is (underground, underwater)
+        bool depends_on_location() const;
+
         // this enchantment is active when wielded.
         // shows total conditional values, so only use this when Character is not available
         bool active_wield() const;
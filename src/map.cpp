@@ -44,6 +44,7 @@
 #include "fragment_cloud.h"
 #include "fungal_effects.h"
 #include "game.h"
+#include "hash_utils.h"
 #include "harvest.h"
 #include "iexamine.h"
 #include "item.h"
@@ -74,7 +75,9 @@
 #include "overmapbuffer.h"
 #include "pathfinding.h"
 #include "player.h"
+#include "profiler.h"
 #include "projectile.h"
+#include "regional_settings.h"
 #include "relic.h"
 #include "ret_val.h"
 #include "rng.h"
@@ -234,6 +237,8 @@ void map::add_vehicle_to_cache( vehicle *veh )
         return;
     }
 
+    // Vehicles may provide support for seeing across z-levels
+    invalidate_los_cache();
     // Get parts
     for( const vpart_reference &vpr : veh->get_all_parts() ) {
         if( vpr.part().removed ) {
@@ -255,6 +260,7 @@ void map::clear_vehicle_point_from_cache( vehicle *veh, const tripoint &pt )
         return;
     }
 
+    invalidate_los_cache();
     level_cache &ch = get_cache( pt.z );
     if( inbounds( pt ) ) {
         ch.set_veh_exists_at( pt, false );
@@ -264,6 +270,7 @@ void map::clear_vehicle_point_from_cache( vehicle *veh, const tripoint &pt )
 
 void map::clear_vehicle_level_caches( )
 {
+    invalidate_los_cache();
     for( int gridz = -OVERMAP_DEPTH; gridz <= OVERMAP_HEIGHT; gridz++ ) {
         level_cache &ch = get_cache( gridz );
         ch.clear_vehicle_cache();
@@ -355,6 +362,7 @@ void map::on_vehicle_moved( const int smz )
 
 void map::vehmove()
 {
+    CATA_PROFILE_ZONE( "map::vehmove" );
     // give vehicles movement points
     VehicleList vehicle_list;
     int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
@@ -1292,6 +1300,109 @@ void map::set( const tripoint &p, const ter_id &new_terrain, const furn_id &new_
     ter_set( p, new_terrain );
 }
 
+void map::set_ter_furn_rect( const tripoint &origin, const point &size,
+                             const std::vector<ter_furn_id> &plane )
+{
+    bool indoors_changed = false;
+    bool floor_changed = false;
+    bool roof_changed = false;
+    bool any_changed = false;
+    for( int y = 0; y < size.y; y++ ) {
+        for( int x = 0; x < size.x; x++ ) {
+            const ter_furn_id &tdata = plane[y * size.x + x];
+            if( tdata.ter == t_null && tdata.furn == f_null ) {
+                continue;
+            }
+            const tripoint p = origin + point( x, y );
+            if( !inbounds( p ) ) {
+                continue;
+            }
+            point l;
+            submap *const current_submap = unsafe_get_submap_at( p, l );
+            if( current_submap == nullptr ) {
+                debugmsg( "Tried to set terrain at (%d,%d) but the submap is not loaded", l.x, l.y );
+                continue;
+            }
+            bool changed = false;
+            bool transparency_changed = false;
+
+            const furn_id old_furn = current_submap->get_furn( l );
+            if( tdata.furn != f_null && tdata.furn != old_furn ) {
+                current_submap->set_furn( l, tdata.furn );
+                const furn_t &old_t = old_furn.obj();
+                const furn_t &new_t = tdata.furn.obj();
+                if( !new_t.emissions.empty() ) {
+                    field_furn_locs.push_back( p );
+                }
+                transparency_changed |= old_t.transparent != new_t.transparent;
+                indoors_changed |= old_t.has_flag( TFLAG_INDOORS ) != new_t.has_flag( TFLAG_INDOORS );
+                floor_changed |= old_t.has_flag( TFLAG_NO_FLOOR ) != new_t.has_flag( TFLAG_NO_FLOOR );
+                roof_changed |= old_t.has_flag( TFLAG_SUN_ROOF_ABOVE ) !=
+                                new_t.has_flag( TFLAG_SUN_ROOF_ABOVE );
+                support_dirty( p );
+                changed = true;
+            }
+
+            const ter_id old_ter = current_submap->get_ter( l );
+            if( tdata.ter != t_null && tdata.ter != old_ter ) {
+                current_submap->set_ter( l, tdata.ter );
+                const ter_t &old_t = old_ter.obj();
+                const ter_t &new_t = tdata.ter.obj();
+                // HACK: Hack around ledges in traplocs or else it gets NASTY in z-level mode
+                if( old_t.trap != tr_null && old_t.trap != tr_ledge ) {
+                    auto &traps = traplocs[old_t.trap.to_i()];
+                    const auto iter = std::find( traps.begin(), traps.end(), p );
+                    if( iter != traps.end() ) {
+                        traps.erase( iter );
+                    }
+                }
+                if( new_t.trap != tr_null && new_t.trap != tr_ledge ) {
+                    traplocs[new_t.trap.to_i()].push_back( p );
+                }
+                if( !new_t.emissions.empty() ) {
+                    field_ter_locs.push_back( p );
+                }
+                transparency_changed |= old_t.transparent != new_t.transparent;
+                indoors_changed |= old_t.has_flag( TFLAG_INDOORS ) != new_t.has_flag( TFLAG_INDOORS );
+                if( old_t.has_flag( TFLAG_NO_FLOOR ) != new_t.has_flag( TFLAG_NO_FLOOR ) ) {
+                    floor_changed = true;
+                    // It's a set, not a flag
+                    support_cache_dirty.insert( p );
+                }
+                changed = true;
+            }
+
+            if( transparency_changed ) {
+                set_transparency_cache_dirty( p );
+                set_seen_cache_dirty( p );
+            }
+            if( changed ) {
+                any_changed = true;
+                set_memory_seen_cache_dirty( p );
+                // Make sure that if we supported something and no longer do so, it falls down
+                support_dirty( p + tripoint_above );
+            }
+        }
+    }
+
+    if( !any_changed ) {
+        return;
+    }
+    const int z = origin.z;
+    if( indoors_changed ) {
+        set_outside_cache_dirty( z );
+    }
+    if( floor_changed ) {
+        set_floor_cache_dirty( z );
+        set_seen_cache_dirty( z );
+    }
+    if( roof_changed ) {
+        set_floor_cache_dirty( z + 1 );
+    }
+    invalidate_max_populated_zlev( z );
+    set_pathfinding_cache_dirty( z );
+}
+
 std::string map::name( const tripoint &p )
 {
     return has_furn( p ) ? furnname( p ) : tername( p );
@@ -1802,7 +1913,7 @@ int map::move_cost( const tripoint &p, const vehicle *ignored_vehicle ) const
         return 0;
     }
     point l;
-    submap *const current_submap = unsafe_get_submap_at( p, l );
+    const submap *const current_submap = unsafe_get_submap_at( p, l );
     if( current_submap == nullptr ) {
         return 0;
     }
@@ -2737,13 +2848,16 @@ void map::decay_fields_and_scent( const time_duration &amount )
                     const int x = sx + smx * SEEX;
                     const int y = sy + smy * SEEY;
 
-                    const field &fields = cur_submap->get_field( { sx, sy} );
+                    const field *const fields = cur_submap->get_field_if_any( { sx, sy } );
+                    if( fields == nullptr ) {
+                        continue;
+                    }
                     if( !outside_cache[x][y] ) {
-                        to_proc -= fields.field_count();
+                        to_proc -= fields->field_count();
                         continue;
                     }
 
-                    for( const auto &fp : fields ) {
+                    for( const auto &fp : *fields ) {
                         to_proc--;
                         field_entry cur = fp.second;
                         const field_type_id type = cur.get_field_type();
@@ -4232,7 +4346,11 @@ void map::i_clear( const tripoint &p )
         return;
     }
 
-    for( item &it : current_submap->get_items( l ) ) {
+    cata::colony<item> *const items = current_submap->get_items_if_any( l );
+    if( items == nullptr ) {
+        return;
+    }
+    for( item &it : *items ) {
         // remove from the active items cache (if it isn't there does nothing)
         current_submap->active_items.remove( &it );
     }
@@ -4241,7 +4359,7 @@ void map::i_clear( const tripoint &p )
     }
 
     current_submap->set_lum( l, 0 );
-    current_submap->get_items( l ).clear();
+    items->clear();
 }
 
 std::vector<item *> map::spawn_items( const tripoint &p, const std::vector<item> &new_items )
@@ -4729,6 +4847,7 @@ std::vector<tripoint> map::check_submap_active_item_consistency()
 
 void map::process_items()
 {
+    CATA_PROFILE_ZONE( "map::process_items" );
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int gz = minz; gz <= maxz; ++gz ) {
@@ -4944,7 +5063,7 @@ bool map::has_items( const tripoint &p ) const
     }
 
     point l;
-    submap *const current_submap = unsafe_get_submap_at( p, l );
+    const submap *const current_submap = unsafe_get_submap_at( p, l );
     if( current_submap == nullptr ) {
         debugmsg( "Tried to check items at (%d,%d) but the submap is not loaded", l.x, l.y );
         return false;
@@ -5285,7 +5404,7 @@ const field &map::field_at( const tripoint &p ) const
     }
 
     point l;
-    submap *const current_submap = unsafe_get_submap_at( p, l );
+    const submap *const current_submap = unsafe_get_submap_at( p, l );
     if( current_submap == nullptr ) {
         debugmsg( "Tried to get field at (%d,%d) but the submap is not loaded", l.x, l.y );
         nulfield = field();
@@ -5389,7 +5508,8 @@ field_entry *map::get_field( const tripoint &p, const field_type_id &type ) cons
         return nullptr;
     }
 
-    return current_submap->get_field( l ).find_field( type );
+    field *const fields = current_submap->get_field_if_any( l );
+    return fields == nullptr ? nullptr : fields->find_field( type );
 }
 
 bool map::dangerous_field_at( const tripoint &p )
@@ -6172,17 +6292,15 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         bresenham_slope = 0;
         return false; // Out of range!
     }
-    // Cannonicalize the order of the tripoints so the cache is reflexive.
-    const tripoint &min = F < T ? F : T;
-    const tripoint &max = !( F < T ) ? F : T;
-    // A little gross, just pack the values into a point.
-    const point key(
-        min.x << 16 | min.y << 8 | ( min.z + OVERMAP_DEPTH ),
-        max.x << 16 | max.y << 8 | ( max.z + OVERMAP_DEPTH )
-    );
-    char cached = skew_vision_cache.get( key, -1 );
-    if( cached >= 0 ) {
-        return cached > 0;
+    // Only the plain line is cached, callers searching for a path (see find_clear_path)
+    // try several skewed lines between the same pair of points.
+    const bool use_cache = bresenham_slope == 0 && los_cache::can_cache( F ) &&
+                           los_cache::can_cache( T );
+    if( use_cache ) {
+        const int cached = skew_vision_cache.get( F, T, los_generation );
+        if( cached >= 0 ) {
+            return cached > 0;
+        }
     }
     bool visible = true;
 
@@ -6200,7 +6318,9 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
             }
             return true;
         } );
-        skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+        if( use_cache ) {
+            skew_vision_cache.set( F, T, los_generation, visible );
+        }
         return visible;
     }
 
@@ -6233,10 +6353,29 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         last_point = new_point;
         return true;
     } );
-    skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+    if( use_cache ) {
+        skew_vision_cache.set( F, T, los_generation, visible );
+    }
     return visible;
 }
 
+std::vector<bool> map::sees( const tripoint &F, const std::vector<tripoint> &targets,
+                             const int range ) const
+{
+    std::vector<bool> result( targets.size(), false );
+    if( !inbounds( F ) ) {
+        return result;
+    }
+    for( size_t i = 0; i < targets.size(); ++i ) {
+        const tripoint &T = targets[i];
+        if( ( range >= 0 && range < rl_dist( F, T ) ) || !has_potential_los( F, T ) ) {
+            continue;
+        }
+        result[i] = sees( F, T, range );
+    }
+    return result;
+}
+
 int map::obstacle_coverage( const tripoint &loc1, const tripoint &loc2 ) const
 {
     // Can't hide if you are standing on furniture, or non-flat slowing-down terrain tile.
@@ -6550,12 +6689,14 @@ void map::save()
 
 void map::load( const tripoint_abs_sm &w, const bool update_vehicle )
 {
+    prefetch_queue.clear();
     for( auto &traps : traplocs ) {
         traps.clear();
     }
     field_furn_locs.clear();
     field_ter_locs.clear();
     submaps_with_active_items.clear();
+    release_leaving_submaps( w.raw() );
     // TODO: fix point types
     set_abs_sub( w.raw() );
     clear_vehicle_level_caches();
@@ -6645,6 +6786,31 @@ shift_bitset_cache<MAPSIZE_X, SEEX>( std::bitset<MAPSIZE_X *MAPSIZE_X> &cache,
 template void
 shift_bitset_cache<MAPSIZE, 1>( std::bitset<MAPSIZE *MAPSIZE> &cache, const point &s );
 
+void map::release_leaving_submaps( const tripoint &new_abs_sub )
+{
+    if( g == nullptr || this != &get_map() ) {
+        return;
+    }
+    const point offset = abs_sub.xy() - new_abs_sub.xy();
+    const bool same_levels = zlevels || new_abs_sub.z == abs_sub.z;
+    const int zmin = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
+    const int zmax = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
+    for( int gridz = zmin; gridz <= zmax; gridz++ ) {
+        for( int gridx = 0; gridx < my_MAPSIZE; gridx++ ) {
+            for( int gridy = 0; gridy < my_MAPSIZE; gridy++ ) {
+                const point moved = point( gridx, gridy ) + offset;
+                if( same_levels && moved.x >= 0 && moved.x < my_MAPSIZE &&
+                    moved.y >= 0 && moved.y < my_MAPSIZE ) {
+                    continue;
+                }
+                if( submap *const sm = getsubmap( get_nonant( { gridx, gridy, gridz } ) ) ) {
+                    sm->release_empty_squares();
+                }
+            }
+        }
+    }
+}
+
 void map::shift( const point &sp )
 {
     // Special case of 0-shift; refresh the map
@@ -6658,7 +6824,9 @@ void map::shift( const point &sp )
 
     const tripoint abs = get_abs_sub();
 
+    release_leaving_submaps( abs + sp );
     set_abs_sub( abs + sp );
+    invalidate_los_cache();
 
     Character &player_character = get_player_character();
     // if player is in vehicle, (s)he must be shifted with vehicle too
@@ -6867,12 +7035,54 @@ static void generate_uniform( const tripoint &p, const ter_id &terrain_type )
     }
 }
 
-void map::loadn( const tripoint &grid, const bool update_vehicles, bool _actualize )
+// Returns the terrain an overmap terrain is uniformly made of, t_null if it needs mapgen.
+static ter_id uniform_terrain( const oter_id &terrain_type )
 {
     // Cache empty overmap types
     static const oter_id rock( "empty_rock" );
     static const oter_id air( "open_air" );
 
+    // TODO: Replace with json mapgen functions.
+    if( terrain_type == air ) {
+        return t_open_air;
+    } else if( terrain_type == rock ) {
+        return t_rock;
+    }
+    return t_null;
+}
+
+static unsigned int mapgen_seed( const tripoint_abs_omt &p )
+{
+    size_t seed = g != nullptr ? g->get_seed() : 0;
+    cata::hash_combine( seed, p.x() );
+    cata::hash_combine( seed, p.y() );
+    cata::hash_combine( seed, p.z() );
+    return static_cast<unsigned int>( seed );
+}
+
+// Generates the four submaps of an overmap terrain into the mapbuffer.
+static void generate_omt( const tripoint_abs_omt &p )
+{
+    // Each overmap terrain draws from its own stream, seeded by the world and its position, so
+    // its mapgen does not depend on (or change) the random numbers drawn around it.  Whether
+    // it is generated ahead of time by process_prefetch or when the map gets to it makes no
+    // difference to the rest of the game.
+    const rng_seed_scope seeded( mapgen_seed( p ) );
+    // TODO: fix point types
+    const tripoint abs_sub = omt_to_sm_copy( p.raw() );
+    // Short-circuit if the map tile is uniform
+    const ter_id uniform = uniform_terrain( overmap_buffer.ter( p ) );
+    if( uniform != t_null ) {
+        generate_uniform( abs_sub, uniform );
+    } else {
+        tinymap tmp_map;
+        tmp_map.generate( abs_sub, calendar::turn );
+    }
+}
+
+void map::loadn( const tripoint &grid, const bool update_vehicles, bool _actualize )
+{
+    CATA_PROFILE_ZONE( "map::loadn" );
     dbg( D_INFO ) << "map::loadn(game[" << g.get() << "], worldx[" << abs_sub.x
                   << "], worldy[" << abs_sub.y << "], grid " << grid << ")";
 
@@ -6892,21 +7102,7 @@ void map::loadn( const tripoint &grid, const bool update_vehicles, bool _actuali
         // Each overmap square is two nonants; to prevent overlap, generate only at
         //  squares divisible by 2.
         // TODO: fix point types
-        const tripoint_abs_omt grid_abs_omt( sm_to_omt_copy( grid_abs_sub ) );
-        const tripoint grid_abs_sub_rounded = omt_to_sm_copy( grid_abs_omt.raw() );
-
-        const oter_id terrain_type = overmap_buffer.ter( grid_abs_omt );
-
-        // Short-circuit if the map tile is uniform
-        // TODO: Replace with json mapgen functions.
-        if( terrain_type == air ) {
-            generate_uniform( grid_abs_sub_rounded, t_open_air );
-        } else if( terrain_type == rock ) {
-            generate_uniform( grid_abs_sub_rounded, t_rock );
-        } else {
-            tinymap tmp_map;
-            tmp_map.generate( grid_abs_sub_rounded, calendar::turn );
-        }
+        generate_omt( tripoint_abs_omt( sm_to_omt_copy( grid_abs_sub ) ) );
 
         // This is the same call to MAPBUFFER as above!
         tmpsub = MAPBUFFER.lookup_submap( grid_abs_sub );
@@ -6915,6 +7111,9 @@ void map::loadn( const tripoint &grid, const bool update_vehicles, bool _actuali
             debugmsg( "failed to generate a submap at %s", grid_abs_sub.to_string() );
             return;
         }
+    } else if( tmpsub->last_touched == calendar::before_time_starts ) {
+        // Generated ahead of time by process_prefetch, it enters the world only now.
+        tmpsub->last_touched = calendar::turn;
     }
 
     // New submap changes the content of the map and all caches must be recalculated
@@ -6970,6 +7169,76 @@ void map::loadn( const tripoint &grid, const bool update_vehicles, bool _actuali
     abs_sub.z = old_abs_z;
 }
 
+void map::prefetch_ahead( const point &shift )
+{
+    prefetch_queue.clear();
+    // The submaps loaded by the next two shifts, that is at least the next overmap terrain
+    // in that direction, whatever the alignment of the map and the overmap terrains.
+    std::vector<std::pair<point, point>> strips;
+    if( shift.x != 0 ) {
+        const int x = shift.x > 0 ? my_MAPSIZE : -2;
+        strips.emplace_back( point( x, -2 ), point( x + 1, my_MAPSIZE + 1 ) );
+    }
+    if( shift.y != 0 ) {
+        const int y = shift.y > 0 ? my_MAPSIZE : -2;
+        strips.emplace_back( point( -2, y ), point( my_MAPSIZE + 1, y + 1 ) );
+    }
+    // The current level first, the others are mostly empty air or rock
+    std::vector<int> levels{ abs_sub.z };
+    if( zlevels ) {
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+            if( z != abs_sub.z ) {
+                levels.push_back( z );
+            }
+        }
+    }
+    for( const int z : levels ) {
+        for( const std::pair<point, point> &strip : strips ) {
+            // TODO: fix point types
+            const point omt_min = sm_to_omt_copy( abs_sub.xy() + strip.first );
+            const point omt_max = sm_to_omt_copy( abs_sub.xy() + strip.second );
+            for( int x = omt_min.x; x <= omt_max.x; x++ ) {
+                for( int y = omt_min.y; y <= omt_max.y; y++ ) {
+                    const tripoint_abs_omt p( x, y, z );
+                    if( std::find( prefetch_queue.begin(), prefetch_queue.end(),
+                                   p ) == prefetch_queue.end() ) {
+                        prefetch_queue.push_back( p );
+                    }
+                }
+            }
+        }
+    }
+}
+
+void map::process_prefetch()
+{
+    while( !prefetch_queue.empty() ) {
+        const tripoint_abs_omt p = prefetch_queue.front();
+        prefetch_queue.pop_front();
+        // Overmaps take a while to generate, leave those that need one to loadn.
+        // Uniform terrains are cheap enough to generate when the map gets to them.
+        if( !overmap_buffer.has( project_to<coords::om>( p.xy() ) ) ||
+            uniform_terrain( overmap_buffer.ter( p ) ) != t_null ) {
+            continue;
+        }
+        CATA_PROFILE_ZONE( "map::process_prefetch" );
+        // Looking the submap up loads it from disk if it was saved, which is worth a turn too.
+        // TODO: fix point types
+        const tripoint abs_sub = omt_to_sm_copy( p.raw() );
+        if( MAPBUFFER.lookup_submap( abs_sub ) == nullptr ) {
+            generate_omt( p );
+            // Nothing happens to the new submaps until the map gets to them, loadn sets
+            // the time they were last touched then.
+            for( const point &offset : { point_zero, point_east, point_south, point_south_east } ) {
+                if( submap *sm = MAPBUFFER.lookup_submap( abs_sub + offset ) ) {
+                    sm->last_touched = calendar::before_time_starts;
+                }
+            }
+        }
+        return;
+    }
+}
+
 void map::rotten_item_spawn( const item &item, const tripoint &pnt )
 {
     if( g->critter_at( pnt ) != nullptr ) {
@@ -7815,6 +8084,7 @@ int map::determine_wall_corner( const tripoint &p ) const
 
 void map::build_outside_cache( const int zlev )
 {
+    CATA_PROFILE_ZONE( "map::build_outside_cache" );
     auto &ch = get_cache( zlev );
     if( !ch.outside_cache_dirty ) {
         return;
@@ -7973,6 +8243,7 @@ std::bitset<OVERMAP_LAYERS> map::get_inter_level_visibility( const int origin_zl
 
 bool map::build_floor_cache( const int zlev )
 {
+    CATA_PROFILE_ZONE( "map::build_floor_cache" );
     auto &ch = get_cache( zlev );
     if( !ch.floor_cache_dirty ) {
         return false;
@@ -8020,6 +8291,7 @@ bool map::build_floor_cache( const int zlev )
     }
 
     ch.floor_cache_dirty = false;
+    invalidate_los_cache();
     return zlevels;
 }
 
@@ -8032,7 +8304,8 @@ void map::build_floor_caches()
     }
 }
 
-static void vehicle_caching_internal( level_cache &zch, const vpart_reference &vp, vehicle *v )
+// Returns true if any of the caches changed.
+static bool vehicle_caching_internal( level_cache &zch, const vpart_reference &vp, vehicle *v )
 {
     auto &outside_cache = zch.outside_cache;
     auto &transparency_cache = zch.transparency_cache;
@@ -8040,13 +8313,16 @@ static void vehicle_caching_internal( level_cache &zch, const vpart_reference &v
 
     const size_t part = vp.part_index();
     const tripoint &part_pos =  v->global_part_pos3( vp.part() );
+    bool changed = false;
 
     bool vehicle_is_opaque = vp.has_feature( VPFLAG_OPAQUE ) && !vp.part().is_broken();
 
     if( vehicle_is_opaque ) {
         int dpart = v->part_with_feature( part, VPFLAG_OPENABLE, true );
         if( dpart < 0 || !v->part( dpart ).open ) {
-            transparency_cache[part_pos.x][part_pos.y] = LIGHT_TRANSPARENCY_SOLID;
+            float &transparency = transparency_cache[part_pos.x][part_pos.y];
+            changed |= transparency != LIGHT_TRANSPARENCY_SOLID;
+            transparency = LIGHT_TRANSPARENCY_SOLID;
         } else {
             vehicle_is_opaque = false;
         }
@@ -8057,38 +8333,49 @@ static void vehicle_caching_internal( level_cache &zch, const vpart_reference &v
     }
 
     if( vp.has_feature( VPFLAG_BOARDABLE ) && !vp.part().is_broken() ) {
+        changed |= !floor_cache[part_pos.x][part_pos.y];
         floor_cache[part_pos.x][part_pos.y] = true;
     }
+    return changed;
 }
 
-static void vehicle_caching_internal_above( level_cache &zch_above, const vpart_reference &vp,
+static bool vehicle_caching_internal_above( level_cache &zch_above, const vpart_reference &vp,
         vehicle *v )
 {
     if( vp.has_feature( VPFLAG_ROOF ) || vp.has_feature( VPFLAG_OPAQUE ) ) {
         const tripoint &part_pos = v->global_part_pos3( vp.part() );
+        const bool changed = !zch_above.floor_cache[part_pos.x][part_pos.y];
         zch_above.floor_cache[part_pos.x][part_pos.y] = true;
+        return changed;
     }
+    return false;
 }
 
 void map::do_vehicle_caching( int z )
 {
+    CATA_PROFILE_ZONE( "map::do_vehicle_caching" );
     level_cache &ch = get_cache( z );
+    bool changed = false;
     for( vehicle *v : ch.vehicle_list ) {
         for( const vpart_reference &vp : v->get_all_parts() ) {
             const tripoint &part_pos = v->global_part_pos3( vp.part() );
             if( !inbounds( part_pos.xy() ) ) {
                 continue;
             }
-            vehicle_caching_internal( get_cache( part_pos.z ), vp, v );
+            changed |= vehicle_caching_internal( get_cache( part_pos.z ), vp, v );
             if( part_pos.z < OVERMAP_HEIGHT ) {
-                vehicle_caching_internal_above( get_cache( part_pos.z + 1 ), vp, v );
+                changed |= vehicle_caching_internal_above( get_cache( part_pos.z + 1 ), vp, v );
             }
         }
     }
+    if( changed ) {
+        invalidate_los_cache();
+    }
 }
 
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
+    CATA_PROFILE_ZONE( "map::build_map_cache" );
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
@@ -8112,9 +8399,6 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
 
     seen_cache_dirty |= build_vision_transparency_cache( zlev );
 
-    if( seen_cache_dirty ) {
-        skew_vision_cache.clear();
-    }
     // Initial value is illegal player position.
     const tripoint &p = get_player_character().pos();
     static tripoint player_prev_pos;
@@ -7,6 +7,7 @@
 #include <climits>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <iosfwd>
 #include <list>
@@ -31,7 +32,7 @@
 #include "level_cache.h"
 #include "lightmap.h"
 #include "line.h"
-#include "lru_cache.h"
+#include "los_cache.h"
 #include "map_selector.h"
 #include "mapdata.h"
 #include "optional.h"
@@ -68,6 +69,7 @@ struct fragment_cloud;
 struct maptile;
 struct partial_con;
 struct spawn_data;
+struct ter_furn_id;
 struct trap;
 template<typename Tripoint>
 class tripoint_range;
@@ -214,6 +216,7 @@ class map
         /*@{*/
         void set_transparency_cache_dirty( const int zlev ) {
             if( inbounds_z( zlev ) ) {
+                invalidate_los_cache();
                 get_cache( zlev ).transparency_cache_dirty.set();
                 get_cache( zlev ).r_hor_cache->invalidate();
                 get_cache( zlev ).r_up_cache->invalidate();
@@ -228,6 +231,7 @@ class map
         //      so passing field=true allows to skip rebuilding of such caches
         void set_transparency_cache_dirty( const tripoint &p, bool field = false ) {
             if( inbounds( p ) ) {
+                invalidate_los_cache();
                 const tripoint smp = ms_to_sm_copy( p );
                 get_cache( smp.z ).transparency_cache_dirty.set( smp.x * MAPSIZE + smp.y );
                 if( !field ) {
@@ -266,6 +270,7 @@ class map
 
         void set_floor_cache_dirty( const int zlev ) {
             if( inbounds_z( zlev ) ) {
+                invalidate_los_cache();
                 get_cache( zlev ).floor_cache_dirty = true;
             }
         }
@@ -273,6 +278,20 @@ class map
         void set_pathfinding_cache_dirty( int zlev );
         /*@}*/
 
+        /**
+         * Forgets all line of sight results memoised by @ref sees.
+         *
+         * Called whenever anything sees() depends on (transparency, floors,
+         * vehicles, the map position) may have changed, so cached answers are
+         * always the same as freshly computed ones.
+         */
+        void invalidate_los_cache() {
+            // 0 marks unused los_cache entries, skip it when wrapping around
+            if( ++los_generation == 0 ) {
+                los_generation = 1;
+            }
+        }
+
         void set_memory_seen_cache_dirty( const tripoint &p ) {
             const int offset = p.x + p.y * MAPSIZE_Y;
             if( offset >= 0 && offset < MAPSIZE_X * MAPSIZE_Y ) {
@@ -418,6 +437,19 @@ class map
          * Note: the map must have been loaded before this can be called.
          */
         void shift( const point &s );
+        /**
+         * Queues the overmap terrains the map would load if it kept being shifted by @p shift,
+         * for process_prefetch to generate ahead of time.
+         */
+        void prefetch_ahead( const point &shift );
+        /**
+         * Generates (or loads from disk) the next overmap terrain queued by prefetch_ahead that
+         * is not in the mapbuffer yet.  Called once per turn, this spreads the mapgen of a new
+         * row of the map over the turns it takes to get there, instead of running it all
+         * at once when the map shifts.  The mapgen still runs on the main thread, within
+         * the turn that calls this.
+         */
+        void process_prefetch();
         /**
          * Moves the map vertically to (not by!) newz.
          * Does not actually shift anything, only forces cache updates.
@@ -514,6 +546,13 @@ class map
         * Returns whether `F` sees `T` with a view range of `range`.
         */
         bool sees( const tripoint &F, const tripoint &T, int range ) const;
+        /**
+         * Batched version of the above: whether `F` sees each of `targets`.
+         * Targets that can not possibly be in view are rejected before any line is traced,
+         * the remaining lines are shared with other callers through the line of sight cache.
+         */
+        std::vector<bool> sees( const tripoint &F, const std::vector<tripoint> &targets,
+                                int range ) const;
     private:
         /**
          * Don't expose the slope adjust outside map functions.
@@ -670,6 +709,15 @@ class map
             furn_set( p, new_furniture );
             ter_set( p, new_terrain );
         }
+        /**
+         * Sets the terrain and furniture of a rectangle from @p plane, which holds @p size.x by
+         * @p size.y entries row by row, starting at @p origin.  Null entries leave the square as
+         * it is.  Does what ter_set and furn_set would do for each square, but invalidates the
+         * caches once for the whole rectangle.  Meant for mapgen: unlike furn_set, this does not
+         * care about creatures or grabbed furniture on the squares.
+         */
+        void set_ter_furn_rect( const tripoint &origin, const point &size,
+                                const std::vector<ter_furn_id> &plane );
         std::string name( const tripoint &p );
         std::string name( const point &p ) {
             return name( tripoint( p, abs_sub.z ) );
@@ -1625,6 +1673,12 @@ class map
          * @param shift The amount shifting in submap, the same as go into @ref shift.
          */
         void shift_traps( const tripoint &shift );
+        /**
+         * Frees the storage the squares of the submaps that leave the reality bubble when it
+         * moves to @p new_abs_sub were given for items and fields they do not have (see
+         * submap::release_empty_squares).  Does nothing for maps other than the game map.
+         */
+        void release_leaving_submaps( const tripoint &new_abs_sub );
 
         void copy_grid( const tripoint &to, const tripoint &from );
         void draw_map( mapgendata &dat );
@@ -1873,8 +1927,13 @@ class map
 
         /**
          * Cache of coordinate pairs recently checked for visibility.
+         * Entries are only valid for the current @ref los_generation.
          */
-        mutable lru_cache<point, char> skew_vision_cache;
+        mutable los_cache skew_vision_cache;
+        uint32_t los_generation = 1;
+
+        /** Overmap terrains to generate ahead of time, see @ref prefetch_ahead. */
+        std::deque<tripoint_abs_omt> prefetch_queue;
 
         // Note: no bounds check
         level_cache &get_cache( int zlev ) const {
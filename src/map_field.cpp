@@ -55,6 +55,7 @@
 #include "overmapbuffer.h"
 #include "player.h"
 #include "point.h"
+#include "profiler.h"
 #include "rng.h"
 #include "scent_block.h"
 #include "scent_map.h"
@@ -145,6 +146,7 @@ int map::burn_body_part( player &u, field_entry &cur, const bodypart_id &bp, con
 
 void map::process_fields()
 {
+    CATA_PROFILE_ZONE( "map::process_fields" );
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int z = minz; z <= maxz; z++ ) {
@@ -1,30 +1,519 @@
 #include "map_memory.h"
 
-static const memorized_terrain_tile default_tile{ "", 0, 0 };
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <utility>
+#include <vector>
 
-memorized_terrain_tile map_memory::get_tile( const tripoint &pos ) const
+#include "cata_utility.h"
+#include "filesystem.h"
+#include "game_constants.h"
+#include "json.h"
+#include "string_formatter.h"
+#include "translations.h"
+
+static_assert( SEEX == SEEY, "map memory chunks are square" );
+
+/** Width of a region file, in chunks. */
+static constexpr int MM_REG_SIZE = 8;
+
+struct map_memory::chunk {
+    struct cell {
+        /** Index into the table of interned tiles, 0 is the blank tile. */
+        uint32_t tile = 0;
+        int symbol = 0;
+    };
+    std::array<cell, SEEX * SEEY> cells;
+
+    static uint32_t intern_tile( const std::string &ter, int subtile, int rotation );
+    static const memorized_terrain_tile &tile_of( uint32_t id );
+    static size_t index( const tripoint &pos );
+};
+
+namespace
+{
+struct tile_table {
+    // A deque, so the references get_tile hands out stay valid as the table grows.
+    std::deque<memorized_terrain_tile> tiles;
+    std::unordered_map<std::string, std::vector<uint32_t>> ids;
+
+    tile_table() {
+        tiles.push_back( memorized_terrain_tile{ "", 0, 0 } );
+        ids[""].push_back( 0 );
+    }
+};
+} // namespace
+
+static tile_table &get_tile_table()
+{
+    static tile_table table;
+    return table;
+}
+
+uint32_t map_memory::chunk::intern_tile( const std::string &ter, const int subtile,
+        const int rotation )
+{
+    tile_table &table = get_tile_table();
+    std::vector<uint32_t> &variants = table.ids[ter];
+    // a tile id only ever has a handful of subtile and rotation combinations
+    for( const uint32_t id : variants ) {
+        const memorized_terrain_tile &t = table.tiles[id];
+        if( t.subtile == subtile && t.rotation == rotation ) {
+            return id;
+        }
+    }
+    table.tiles.push_back( memorized_terrain_tile{ ter, subtile, rotation } );
+    variants.push_back( static_cast<uint32_t>( table.tiles.size() - 1 ) );
+    return variants.back();
+}
+
+const memorized_terrain_tile &map_memory::chunk::tile_of( const uint32_t id )
+{
+    return get_tile_table().tiles[id];
+}
+
+size_t map_memory::chunk::index( const tripoint &pos )
+{
+    return static_cast<size_t>( modulo( pos.y, SEEY ) * SEEX + modulo( pos.x, SEEX ) );
+}
+
+static tripoint chunk_pos( const tripoint &pos )
+{
+    return divide_xy_round_to_minus_infinity( pos, SEEX );
+}
+
+static tripoint region_of( const tripoint &chunk )
+{
+    return divide_xy_round_to_minus_infinity( chunk, MM_REG_SIZE );
+}
+
+template<typename F>
+static void for_each_chunk_pos( const tripoint &region, F f )
+{
+    const tripoint origin = multiply_xy( region, MM_REG_SIZE );
+    for( int y = 0; y < MM_REG_SIZE; ++y ) {
+        for( int x = 0; x < MM_REG_SIZE; ++x ) {
+            f( origin + point( x, y ) );
+        }
+    }
+}
+
+map_memory::map_memory() = default;
+map_memory::map_memory( map_memory && ) noexcept = default;
+map_memory::~map_memory() = default;
+map_memory &map_memory::operator=( map_memory && ) noexcept = default;
+
+void map_memory::clear()
+{
+    lru.clear();
+    chunks.clear();
+    loaded_regions.clear();
+    dirty_regions.clear();
+    last_chunk = nullptr;
+}
+
+const map_memory::chunk *map_memory::find_chunk( const tripoint &pos ) const
+{
+    const tripoint cpos = chunk_pos( pos );
+    if( last_chunk != nullptr && last_chunk_pos == cpos ) {
+        return last_chunk;
+    }
+    const auto iter = chunks.find( cpos );
+    if( iter == chunks.end() ) {
+        return nullptr;
+    }
+    if( !iter->second.data ) {
+        load_region( region_of( cpos ) );
+    }
+    last_chunk_pos = cpos;
+    last_chunk = iter->second.data.get();
+    return last_chunk;
+}
+
+map_memory::chunk &map_memory::touch_chunk( const int limit, const tripoint &pos )
+{
+    const tripoint cpos = chunk_pos( pos );
+    const tripoint region = region_of( cpos );
+    // Read the rest of the region before changing it, it is written back as a whole.
+    if( loaded_regions.count( region ) == 0 ) {
+        load_region( region );
+    }
+    dirty_regions.insert( region );
+    auto iter = chunks.find( cpos );
+    if( iter != chunks.end() ) {
+        lru.splice( lru.end(), lru, iter->second.lru_pos );
+        return *iter->second.data;
+    }
+
+    lru.push_back( cpos );
+    iter = chunks.emplace( cpos, chunk_entry() ).first;
+    iter->second.lru_pos = std::prev( lru.end() );
+    iter->second.data = std::make_unique<chunk>();
+    // Forget the least recently memorized chunks, never the one just added.
+    while( lru.size() > static_cast<size_t>( std::max( limit, 1 ) ) ) {
+        const tripoint oldest = lru.front();
+        lru.pop_front();
+        chunks.erase( oldest );
+        dirty_regions.insert( region_of( oldest ) );
+        if( last_chunk_pos == oldest ) {
+            last_chunk = nullptr;
+        }
+    }
+    return *iter->second.data;
+}
+
+const memorized_terrain_tile &map_memory::get_tile( const tripoint &pos ) const
 {
-    return tile_cache.get( pos, default_tile );
+    const chunk *c = find_chunk( pos );
+    return chunk::tile_of( c == nullptr ? 0 : c->cells[chunk::index( pos )].tile );
 }
 
 void map_memory::memorize_tile( int limit, const tripoint &pos, const std::string &ter,
                                 const int subtile, const int rotation )
 {
-    tile_cache.insert( limit, pos, memorized_terrain_tile{ ter, subtile, rotation } );
+    touch_chunk( limit, pos ).cells[chunk::index( pos )].tile =
+        chunk::intern_tile( ter, subtile, rotation );
 }
 
 int map_memory::get_symbol( const tripoint &pos ) const
 {
-    return symbol_cache.get( pos, 0 );
+    const chunk *c = find_chunk( pos );
+    return c == nullptr ? 0 : c->cells[chunk::index( pos )].symbol;
 }
 
 void map_memory::memorize_symbol( int limit, const tripoint &pos, const int symbol )
 {
-    symbol_cache.insert( limit, pos, symbol );
+    touch_chunk( limit, pos ).cells[chunk::index( pos )].symbol = symbol;
 }
 
 void map_memory::clear_memorized_tile( const tripoint &pos )
 {
-    tile_cache.remove( pos );
-    symbol_cache.remove( pos );
+    const tripoint cpos = chunk_pos( pos );
+    const auto iter = chunks.find( cpos );
+    if( iter == chunks.end() ) {
+        return;
+    }
+    if( !iter->second.data ) {
+        load_region( region_of( cpos ) );
+    }
+    iter->second.data->cells[chunk::index( pos )] = chunk::cell();
+    dirty_regions.insert( region_of( cpos ) );
+}
+
+std::string map_memory::region_path( const tripoint &region ) const
+{
+    return string_format( "%s/%d.%d.%d.mmr", save_path, region.x, region.y, region.z );
+}
+
+void map_memory::load_region( const tripoint &region ) const
+{
+    loaded_regions.insert( region );
+    if( !save_path.empty() ) {
+        read_from_file_optional_json( region_path( region ), [this]( JsonIn & jsin ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                jsin.start_array();
+                tripoint cpos;
+                cpos.x = jsin.get_int();
+                cpos.y = jsin.get_int();
+                cpos.z = jsin.get_int();
+                std::unique_ptr<chunk> data = std::make_unique<chunk>();
+                deserialize_chunk( jsin, *data );
+                jsin.end_array();
+                // chunks forgotten since the region was written are skipped
+                const auto iter = chunks.find( cpos );
+                if( iter != chunks.end() && !iter->second.data ) {
+                    iter->second.data = std::move( data );
+                }
+            }
+        } );
+    }
+    // Chunks missing from the file (it was not saved since they were memorized) are blank.
+    for_each_chunk_pos( region, [this]( const tripoint & cpos ) {
+        const auto iter = chunks.find( cpos );
+        if( iter != chunks.end() && !iter->second.data ) {
+            iter->second.data = std::make_unique<chunk>();
+        }
+    } );
+}
+
+bool map_memory::save_region( const tripoint &region )
+{
+    if( loaded_regions.count( region ) == 0 ) {
+        load_region( region );
+    }
+    std::vector<std::pair<tripoint, const chunk *>> contents;
+    for_each_chunk_pos( region, [&]( const tripoint & cpos ) {
+        const auto iter = chunks.find( cpos );
+        if( iter != chunks.end() ) {
+            contents.emplace_back( cpos, iter->second.data.get() );
+        }
+    } );
+    const std::string path = region_path( region );
+    if( contents.empty() ) {
+        return !file_exist( path ) || remove_file( path );
+    }
+    if( !assure_dir_exist( save_path ) ) {
+        return false;
+    }
+    return write_to_file( path, [&]( std::ostream & fout ) {
+        JsonOut jsout( fout );
+        jsout.start_array();
+        for( const std::pair<tripoint, const chunk *> &elem : contents ) {
+            jsout.start_array();
+            jsout.write( elem.first.x );
+            jsout.write( elem.first.y );
+            jsout.write( elem.first.z );
+            serialize_chunk( jsout, *elem.second );
+            jsout.end_array();
+        }
+        jsout.end_array();
+    }, _( "map memory region" ) );
+}
+
+void map_memory::set_save_path( const std::string &path )
+{
+    if( path == save_path ) {
+        return;
+    }
+    // Read everything from the old location, all of it has to be written to the new one.
+    for( const std::pair<const tripoint, chunk_entry> &elem : chunks ) {
+        if( !elem.second.data ) {
+            load_region( region_of( elem.first ) );
+        }
+    }
+    save_path = path;
+    for( const std::pair<const tripoint, chunk_entry> &elem : chunks ) {
+        loaded_regions.insert( region_of( elem.first ) );
+        dirty_regions.insert( region_of( elem.first ) );
+    }
+}
+
+bool map_memory::save_regions()
+{
+    if( save_path.empty() ) {
+        return true;
+    }
+    bool saved = true;
+    for( auto iter = dirty_regions.begin(); iter != dirty_regions.end(); ) {
+        if( save_region( *iter ) ) {
+            iter = dirty_regions.erase( iter );
+        } else {
+            saved = false;
+            ++iter;
+        }
+    }
+    return saved;
+}
+
+void map_memory::prepare_region( const tripoint &center )
+{
+    if( save_path.empty() ) {
+        return;
+    }
+    const tripoint center_region = region_of( chunk_pos( center ) );
+    std::vector<tripoint> far_regions;
+    for( const tripoint &region : loaded_regions ) {
+        if( std::abs( region.x - center_region.x ) > 1 || std::abs( region.y - center_region.y ) > 1 ) {
+            far_regions.push_back( region );
+        }
+    }
+    for( const tripoint &region : far_regions ) {
+        // Changed regions stay in memory until the next save_regions().
+        if( dirty_regions.count( region ) != 0 ) {
+            continue;
+        }
+        for_each_chunk_pos( region, [this]( const tripoint & cpos ) {
+            const auto iter = chunks.find( cpos );
+            if( iter != chunks.end() ) {
+                iter->second.data.reset();
+            }
+        } );
+        loaded_regions.erase( region );
+        last_chunk = nullptr;
+    }
+}
+
+// Chunks are written as a table of the tiles they use followed by run length encoded
+// tile indices into that table and symbols, remembered areas are mostly uniform.
+void map_memory::serialize_chunk( JsonOut &jsout, const chunk &c )
+{
+    std::vector<uint32_t> used_tiles;
+    std::vector<int> tile_runs;
+    std::vector<int> symbol_runs;
+    const auto add_run = []( std::vector<int> &runs, const int value ) {
+        if( !runs.empty() && runs[runs.size() - 2] == value ) {
+            runs.back()++;
+        } else {
+            runs.push_back( value );
+            runs.push_back( 1 );
+        }
+    };
+    for( const chunk::cell &cell : c.cells ) {
+        int local = 0;
+        if( cell.tile != 0 ) {
+            const auto iter = std::find( used_tiles.begin(), used_tiles.end(), cell.tile );
+            local = static_cast<int>( std::distance( used_tiles.begin(), iter ) ) + 1;
+            if( iter == used_tiles.end() ) {
+                used_tiles.push_back( cell.tile );
+            }
+        }
+        add_run( tile_runs, local );
+        add_run( symbol_runs, cell.symbol );
+    }
+
+    jsout.start_array();
+    for( const uint32_t id : used_tiles ) {
+        const memorized_terrain_tile &t = chunk::tile_of( id );
+        jsout.start_array();
+        jsout.write( t.tile );
+        jsout.write( t.subtile );
+        jsout.write( t.rotation );
+        jsout.end_array();
+    }
+    jsout.end_array();
+    jsout.write( tile_runs );
+    jsout.write( symbol_runs );
+}
+
+void map_memory::deserialize_chunk( JsonIn &jsin, chunk &c )
+{
+    std::vector<uint32_t> used_tiles( 1, 0 );
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        jsin.start_array();
+        const std::string tile = jsin.get_string();
+        const int subtile = jsin.get_int();
+        const int rotation = jsin.get_int();
+        jsin.end_array();
+        used_tiles.push_back( chunk::intern_tile( tile, subtile, rotation ) );
+    }
+
+    size_t pos = 0;
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        const int local = jsin.get_int();
+        const int count = jsin.get_int();
+        const uint32_t tile = local >= 0 && static_cast<size_t>( local ) < used_tiles.size() ?
+                              used_tiles[local] : 0;
+        for( int i = 0; i < count && pos < c.cells.size(); ++i ) {
+            c.cells[pos++].tile = tile;
+        }
+    }
+    pos = 0;
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        const int symbol = jsin.get_int();
+        const int count = jsin.get_int();
+        for( int i = 0; i < count && pos < c.cells.size(); ++i ) {
+            c.cells[pos++].symbol = symbol;
+        }
+    }
+}
+
+void map_memory::store( JsonOut &jsout ) const
+{
+    // A version number first, to tell it from the per-tile arrays of the old format.
+    jsout.start_array();
+    jsout.write( 1 );
+    jsout.start_array();
+    for( const tripoint &cpos : lru ) {
+        jsout.start_array();
+        jsout.write( cpos.x );
+        jsout.write( cpos.y );
+        jsout.write( cpos.z );
+        // without a save path there are no region files, the contents go here
+        const chunk_entry &entry = chunks.at( cpos );
+        if( save_path.empty() && entry.data ) {
+            serialize_chunk( jsout, *entry.data );
+        }
+        jsout.end_array();
+    }
+    jsout.end_array();
+    jsout.end_array();
+}
+
+void map_memory::load( JsonIn &jsin )
+{
+    // Legacy loading of object version.
+    if( jsin.test_object() ) {
+        JsonObject jsobj = jsin.get_object();
+        jsobj.allow_omitted_members();
+        load( jsobj );
+        return;
+    }
+    clear();
+    jsin.start_array();
+    if( jsin.test_int() ) {
+        jsin.get_int();
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            jsin.start_array();
+            tripoint cpos;
+            cpos.x = jsin.get_int();
+            cpos.y = jsin.get_int();
+            cpos.z = jsin.get_int();
+            lru.push_back( cpos );
+            chunk_entry &entry = chunks[cpos];
+            entry.lru_pos = std::prev( lru.end() );
+            if( !jsin.end_array() ) {
+                entry.data = std::make_unique<chunk>();
+                deserialize_chunk( jsin, *entry.data );
+                jsin.end_array();
+                // it only goes to the region files once the region is written again
+                dirty_regions.insert( region_of( cpos ) );
+            }
+        }
+        jsin.end_array();
+        return;
+    }
+    // Legacy per-tile format, the list of tiles and then of symbols, least recent first.
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        jsin.start_array();
+        tripoint p;
+        p.x = jsin.get_int();
+        p.y = jsin.get_int();
+        p.z = jsin.get_int();
+        const std::string tile = jsin.get_string();
+        const int subtile = jsin.get_int();
+        const int rotation = jsin.get_int();
+        memorize_tile( std::numeric_limits<int>::max(), p, tile, subtile, rotation );
+        jsin.end_array();
+    }
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        jsin.start_array();
+        tripoint p;
+        p.x = jsin.get_int();
+        p.y = jsin.get_int();
+        p.z = jsin.get_int();
+        const int symbol = jsin.get_int();
+        memorize_symbol( std::numeric_limits<int>::max(), p, symbol );
+        jsin.end_array();
+    }
+    jsin.end_array();
+}
+
+// Deserializer for legacy object-based memory map.
+void map_memory::load( const JsonObject &jsin )
+{
+    clear();
+    for( JsonObject pmap : jsin.get_array( "map_memory_tiles" ) ) {
+        pmap.allow_omitted_members();
+        const tripoint p( pmap.get_int( "x" ), pmap.get_int( "y" ), pmap.get_int( "z" ) );
+        memorize_tile( std::numeric_limits<int>::max(), p, pmap.get_string( "tile" ),
+                       pmap.get_int( "subtile" ), pmap.get_int( "rotation" ) );
+    }
+
+    for( JsonObject pmap : jsin.get_array( "map_memory_curses" ) ) {
+        pmap.allow_omitted_members();
+        const tripoint p( pmap.get_int( "x" ), pmap.get_int( "y" ), pmap.get_int( "z" ) );
+        memorize_symbol( std::numeric_limits<int>::max(), p, pmap.get_int( "symbol" ) );
+    }
 }
@@ -2,9 +2,14 @@
 #ifndef CATA_SRC_MAP_MEMORY_H
 #define CATA_SRC_MAP_MEMORY_H
 
+#include <cstdint>
 #include <iosfwd>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 
-#include "lru_cache.h"
 #include "point.h" // IWYU pragma: keep
 
 class JsonIn;
@@ -17,26 +22,90 @@ struct memorized_terrain_tile {
     int rotation;
 };
 
+/**
+ * The map squares the avatar remembers.
+ *
+ * Memory is kept in chunks of one submap.  Remembered tiles are interned, so a square costs a
+ * couple of integers whatever the length of the tile id, and the capacity limit evicts whole
+ * chunks, least recently memorized first.
+ *
+ * When a save path is set (see set_save_path), the contents of the chunks live in region files
+ * of 8 x 8 chunks in that directory.  Only the list of remembered chunks is kept by store() and
+ * load(), regions are read when a square in them is first looked up or memorized.  Regions
+ * are only written by save_regions(), regions far from the avatar are dropped by prepare_region
+ * once they are saved.
+ */
 class map_memory
 {
     public:
+        map_memory();
+        map_memory( map_memory && ) noexcept;
+        ~map_memory();
+        map_memory &operator=( map_memory && ) noexcept;
+
         void store( JsonOut &jsout ) const;
         void load( JsonIn &jsin );
         void load( const JsonObject &jsin );
 
-        /** Memorizes a given tile; finalize_tile_memory needs to be called after it */
+        /**
+         * Sets the directory the region files are kept in.  If it changes, all the memory is
+         * written to the new directory by the next save_regions().
+         */
+        void set_save_path( const std::string &path );
+        /** Writes the regions changed since they were loaded. Returns false on failure. */
+        bool save_regions();
+        /**
+         * Unloads the regions not around @p center (absolute map square) that are unchanged
+         * since they were last saved.  Nothing is written, changed regions are kept until the
+         * next save_regions().
+         */
+        void prepare_region( const tripoint &center );
+
+        /**
+         * Memorizes a given tile; finalize_tile_memory needs to be called after it.
+         * @param limit Number of submap sized chunks that can be remembered.
+         */
         void memorize_tile( int limit, const tripoint &pos, const std::string &ter,
                             int subtile, int rotation );
         /** Returns last stored map tile in given location */
-        memorized_terrain_tile get_tile( const tripoint &pos ) const;
+        const memorized_terrain_tile &get_tile( const tripoint &pos ) const;
 
         void memorize_symbol( int limit, const tripoint &pos, int symbol );
         int get_symbol( const tripoint &pos ) const;
 
         void clear_memorized_tile( const tripoint &pos );
+
     private:
-        lru_cache<tripoint, memorized_terrain_tile> tile_cache;
-        lru_cache<tripoint, int> symbol_cache;
+        struct chunk;
+        struct chunk_entry {
+            std::list<tripoint>::iterator lru_pos;
+            /** Null while the chunk is only on disk. */
+            std::unique_ptr<chunk> data;
+        };
+
+        void clear();
+        /** Returns the chunk containing @p pos, or null if nothing is remembered there. */
+        const chunk *find_chunk( const tripoint &pos ) const;
+        /** Returns the chunk containing @p pos, creating it and making it the most recent. */
+        chunk &touch_chunk( int limit, const tripoint &pos );
+        void load_region( const tripoint &region ) const;
+        bool save_region( const tripoint &region );
+        std::string region_path( const tripoint &region ) const;
+
+        static void serialize_chunk( JsonOut &jsout, const chunk &c );
+        static void deserialize_chunk( JsonIn &jsin, chunk &c );
+
+        /** Chunk positions (in submaps), least recently memorized first. */
+        std::list<tripoint> lru;
+        // mutable, as lookups load regions from disk
+        mutable std::unordered_map<tripoint, chunk_entry> chunks;
+        mutable std::unordered_set<tripoint> loaded_regions;
+        std::unordered_set<tripoint> dirty_regions;
+        std::string save_path;
+
+        // The last chunk looked up, squares are usually looked up next to each other.
+        mutable tripoint last_chunk_pos;
+        mutable const chunk *last_chunk = nullptr;
 };
 
 #endif // CATA_SRC_MAP_MEMORY_H
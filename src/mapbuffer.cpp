@@ -1,5 +1,6 @@
 #include "mapbuffer.h"
 
+#include <algorithm>
 #include <chrono>
 #include <exception>
 #include <functional>
@@ -21,6 +22,7 @@
 #include "output.h"
 #include "path_info.h"
 #include "popup.h"
+#include "profiler.h"
 #include "string_formatter.h"
 #include "submap.h"
 #include "translations.h"
@@ -40,6 +42,16 @@ static std::string find_dirname( const tripoint &om_addr )
                           segment_addr.y, segment_addr.z );
 }
 
+// Whether the quad at @p om_addr is not part of the map whose origin is at @p map_origin.
+static bool outside_map( const tripoint &om_addr, const tripoint &map_origin, bool map_has_zlevels )
+{
+    const bool zlev_del = !map_has_zlevels && om_addr.z != map_origin.z;
+    return zlev_del ||
+           om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
+           om_addr.x > map_origin.x + HALF_MAPSIZE ||
+           om_addr.y > map_origin.y + HALF_MAPSIZE;
+}
+
 mapbuffer MAPBUFFER;
 
 mapbuffer::mapbuffer() = default;
@@ -52,20 +64,14 @@ mapbuffer::~mapbuffer()
 void mapbuffer::reset()
 {
     for( auto &elem : submaps ) {
-        delete elem.second;
+        delete elem.second.sm;
     }
     submaps.clear();
 }
 
 bool mapbuffer::add_submap( const tripoint &p, submap *sm )
 {
-    if( submaps.count( p ) != 0 ) {
-        return false;
-    }
-
-    submaps[p] = sm;
-
-    return true;
+    return submaps.emplace( p, entry{ sm, ++use_clock } ).second;
 }
 
 bool mapbuffer::add_submap( const tripoint &p, std::unique_ptr<submap> &sm )
@@ -84,7 +90,7 @@ void mapbuffer::remove_submap( tripoint addr )
         debugmsg( "Tried to remove non-existing submap %d,%d,%d", addr.x, addr.y, addr.z );
         return;
     }
-    delete m_target->second;
+    delete m_target->second.sm;
     submaps.erase( m_target );
 }
 
@@ -102,11 +108,13 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
         return nullptr;
     }
 
-    return iter->second;
+    iter->second.last_use = ++use_clock;
+    return iter->second.sm;
 }
 
 void mapbuffer::save( bool delete_after_save )
 {
+    CATA_PROFILE_ZONE( "mapbuffer::save" );
     assure_dir_exist( PATH_INFO::world_base_save_path() + "/maps" );
 
     int num_saved_submaps = 0;
@@ -152,12 +160,8 @@ void mapbuffer::save( bool delete_after_save )
 
         // delete_on_save deletes everything, otherwise delete submaps
         // outside the current map.
-        const bool zlev_del = !map_has_zlevels && om_addr.z != get_map().get_abs_sub().z;
         save_quad( dirname, quad_path, om_addr, submaps_to_delete,
-                   delete_after_save || zlev_del ||
-                   om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
-                   om_addr.x > map_origin.x + HALF_MAPSIZE ||
-                   om_addr.y > map_origin.y + HALF_MAPSIZE );
+                   delete_after_save || outside_map( om_addr, map_origin, map_has_zlevels ) );
         num_saved_submaps += 4;
     }
     for( auto &elem : submaps_to_delete ) {
@@ -165,6 +169,62 @@ void mapbuffer::save( bool delete_after_save )
     }
 }
 
+void mapbuffer::unload_cold( const size_t budget )
+{
+    if( budget == 0 ) {
+        return;
+    }
+    CATA_PROFILE_ZONE( "mapbuffer::unload_cold" );
+    struct quad_use {
+        size_t memory = 0;
+        uint64_t last_use = 0;
+    };
+    const map &here = get_map();
+    const tripoint map_origin = sm_to_omt_copy( here.get_abs_sub() );
+    const bool map_has_zlevels = g != nullptr && here.has_zlevels();
+
+    // The map holds on to its submaps without looking them up again, so those still in it
+    // count as used now. Otherwise the quads around the player would be the first to go once
+    // they leave the map.
+    const uint64_t now = ++use_clock;
+    size_t total = 0;
+    std::unordered_map<tripoint, quad_use> quads;
+    for( auto &elem : submaps ) {
+        const size_t memory = elem.second.sm->memory_usage();
+        total += memory;
+        const tripoint om_addr = sm_to_omt_copy( elem.first );
+        if( outside_map( om_addr, map_origin, map_has_zlevels ) ) {
+            quad_use &use = quads[om_addr];
+            use.memory += memory;
+            use.last_use = std::max( use.last_use, elem.second.last_use );
+        } else {
+            elem.second.last_use = now;
+        }
+    }
+    if( total <= budget ) {
+        return;
+    }
+
+    std::vector<std::pair<tripoint, quad_use>> coldest( quads.begin(), quads.end() );
+    std::sort( coldest.begin(), coldest.end(), []( const std::pair<tripoint, quad_use> &l,
+    const std::pair<tripoint, quad_use> &r ) {
+        return l.second.last_use < r.second.last_use;
+    } );
+    assure_dir_exist( PATH_INFO::world_base_save_path() + "/maps" );
+    std::list<tripoint> submaps_to_delete;
+    for( const std::pair<tripoint, quad_use> &q : coldest ) {
+        if( total <= budget ) {
+            break;
+        }
+        const std::string dirname = find_dirname( q.first );
+        save_quad( dirname, find_quad_path( dirname, q.first ), q.first, submaps_to_delete, true );
+        total -= q.second.memory;
+    }
+    for( const tripoint &p : submaps_to_delete ) {
+        remove_submap( p );
+    }
+}
+
 void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
                            const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                            bool delete_after_save )
@@ -182,8 +242,8 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         submap_addr.x += offsets_offset.x;
         submap_addr.y += offsets_offset.y;
         submap_addrs.push_back( submap_addr );
-        submap *sm = submaps[submap_addr];
-        if( sm != nullptr && !sm->is_uniform ) {
+        const auto iter = submaps.find( submap_addr );
+        if( iter != submaps.end() && !iter->second.sm->is_uniform ) {
             all_uniform = false;
         }
     }
@@ -192,7 +252,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         // Nothing to save - this quad will be regenerated faster than it would be re-read
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
-                if( submaps.count( submap_addr ) > 0 && submaps[submap_addr] != nullptr ) {
+                if( submaps.count( submap_addr ) > 0 ) {
                     submaps_to_delete.push_back( submap_addr );
                 }
             }
@@ -207,15 +267,11 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
         JsonOut jsout( fout );
         jsout.start_array();
         for( auto &submap_addr : submap_addrs ) {
-            if( submaps.count( submap_addr ) == 0 ) {
-                continue;
-            }
-
-            submap *sm = submaps[submap_addr];
-
-            if( sm == nullptr ) {
+            const auto iter = submaps.find( submap_addr );
+            if( iter == submaps.end() ) {
                 continue;
             }
+            submap *sm = iter->second.sm;
 
             jsout.start_object();
 
@@ -228,6 +284,8 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
             jsout.write( submap_addr.z );
             jsout.end_array();
 
+            // Mutable access gives squares storage even if nothing is put there
+            sm->release_empty_squares();
             sm->store( jsout );
 
             jsout.end_object();
@@ -245,6 +303,7 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
 // seeking around in them, so we're using the json streaming API.
 submap *mapbuffer::unserialize_submaps( const tripoint &p )
 {
+    CATA_PROFILE_ZONE( "mapbuffer::unserialize_submaps" );
     // Map the tripoint to the submap quad that stores it.
     const tripoint om_addr = sm_to_omt_copy( p );
     const std::string dirname = find_dirname( om_addr );
@@ -267,12 +326,13 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
         // If it doesn't exist, trigger generating it.
         return nullptr;
     }
-    if( submaps.count( p ) == 0 ) {
+    const auto iter = submaps.find( p );
+    if( iter == submaps.end() ) {
         debugmsg( "file %s did not contain the expected submap %d,%d,%d",
                   quad_path, p.x, p.y, p.z );
         return nullptr;
     }
-    return submaps[ p ];
+    return iter->second.sm;
 }
 
 void mapbuffer::deserialize( JsonIn &jsin )
@@ -2,10 +2,12 @@
 #ifndef CATA_SRC_MAPBUFFER_H
 #define CATA_SRC_MAPBUFFER_H
 
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <list>
-#include <map>
 #include <memory>
+#include <unordered_map>
 
 #include "point.h"
 
@@ -14,6 +16,10 @@ class submap;
 
 /**
  * Store, buffer, save and load the entire world map.
+ *
+ * Submaps are looked up in a hash table, each entry remembering when it was last looked up, so
+ * that unload_cold can save and drop the submaps used least recently once they use more memory
+ * than allowed.
  */
 class mapbuffer
 {
@@ -54,18 +60,25 @@ class mapbuffer
          */
         submap *lookup_submap( const tripoint &p );
 
+        /**
+         * If the submaps use more than @p budget bytes (roughly), saves and removes the quads
+         * looked up least recently until they fit, leaving those of the current map alone.
+         * The submaps of the current map count as looked up by every call, even when nothing
+         * is unloaded.
+         * Like save(), this must not be called while pointers to submaps outside the current
+         * map may be held.
+         */
+        void unload_cold( size_t budget );
+
     private:
-        using submap_map_t = std::map<tripoint, submap *>;
+        struct entry {
+            submap *sm;
+            // Value of use_clock when the submap was last looked up or seen in the current map
+            uint64_t last_use;
+        };
+        using submap_map_t = std::unordered_map<tripoint, entry>;
 
-    public:
-        inline submap_map_t::iterator begin() {
-            return submaps.begin();
-        }
-        inline submap_map_t::iterator end() {
-            return submaps.end();
-        }
 
-    private:
         // There's a very good reason this is private,
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( tripoint addr );
@@ -75,6 +88,7 @@ class mapbuffer
                         const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
         submap_map_t submaps;
+        uint64_t use_clock = 0;
 };
 
 extern mapbuffer MAPBUFFER;
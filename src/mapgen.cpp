@@ -61,6 +61,7 @@
 #include "overmap.h"
 #include "overmapbuffer.h"
 #include "point.h"
+#include "profiler.h"
 #include "ret_val.h"
 #include "rng.h"
 #include "string_formatter.h"
@@ -113,6 +114,7 @@ static void build_mine_room( room_type type, const point &p1, const point &p2,
 // x%2 and y%2 must be 0!
 void map::generate( const tripoint &p, const time_point &when )
 {
+    CATA_PROFILE_ZONE( "map::generate" );
     dbg( D_INFO ) << "map::generate( g[" << g.get() << "], p[" << p << "], "
                   "when[" << to_string( when ) << "] )";
 
@@ -564,7 +566,7 @@ size_t mapgen_function_json_base::calc_index( const point &p ) const
     if( p.y >= mapgensize.y ) {
         debugmsg( "invalid value %zu for y in calc_index", p.y );
     }
-    return p.y * mapgensize.y + p.x;
+    return p.y * mapgensize.x + p.x;
 }
 
 static bool common_check_bounds( const jmapgen_int &x, const jmapgen_int &y,
@@ -2796,23 +2798,7 @@ bool jmapgen_setmap::has_vehicle_collision( const mapgendata &dat, const point &
 
 void mapgen_function_json_base::formatted_set_incredibly_simple( map &m, const point &offset ) const
 {
-    for( int y = 0; y < mapgensize.y; y++ ) {
-        for( int x = 0; x < mapgensize.x; x++ ) {
-            point p( x, y );
-            const size_t index = calc_index( p );
-            const ter_furn_id &tdata = format[index];
-            const point map_pos = p + offset;
-            if( tdata.furn != f_null ) {
-                if( tdata.ter != t_null ) {
-                    m.set( map_pos, tdata.ter, tdata.furn );
-                } else {
-                    m.furn_set( map_pos, tdata.furn );
-                }
-            } else if( tdata.ter != t_null ) {
-                m.ter_set( map_pos, tdata.ter );
-            }
-        }
-    }
+    m.set_ter_furn_rect( tripoint( offset, m.get_abs_sub().z ), mapgensize, format );
 }
 
 bool mapgen_function_json_base::has_vehicle_collision( const mapgendata &dat,
@@ -2846,6 +2832,7 @@ bool mapgen_function_json_base::has_vehicle_collision( const mapgendata &dat,
  */
 void mapgen_function_json::generate( mapgendata &md )
 {
+    CATA_PROFILE_ZONE( "mapgen_function_json::generate" );
     map *const m = &md.m;
     if( fill_ter != t_null ) {
         m->draw_fill_background( fill_ter );
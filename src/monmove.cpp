@@ -40,6 +40,7 @@
 #include "pathfinding.h"
 #include "pimpl.h"
 #include "player.h"
+#include "profiler.h"
 #include "rng.h"
 #include "scent_map.h"
 #include "sounds.h"
@@ -315,6 +316,7 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
 
 void monster::plan()
 {
+    CATA_PROFILE_ZONE( "monster::plan" );
     const auto &factions = g->critter_tracker->factions();
 
     // Bots are more intelligent than most living stuff
@@ -659,6 +661,7 @@ bool monster::die_if_drowning( const tripoint &at_pos, const int chance )
 // 4) Sound-based tracking
 void monster::move()
 {
+    CATA_PROFILE_ZONE( "monster::move" );
     // We decrement wandf no matter what.  We'll save our wander_to plans until
     // after we finish out set_dest plans, UNLESS they time out first.
     if( wandf > 0 ) {
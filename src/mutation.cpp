@@ -108,15 +108,20 @@ bool Character::has_trait( const trait_id &b ) const
 
 bool Character::has_trait_flag( const json_character_flag &b ) const
 {
-    // UGLY, SLOW, should be cached as my_mutation_flags or something
-    for( const trait_id &mut : get_mutations() ) {
-        const mutation_branch &mut_data = mut.obj();
-        if( mut_data.flags.count( b ) > 0 ) {
-            return true;
-        } else if( mut_data.activated ) {
-            Character &player = get_player_character();
-            if( ( mut_data.active_flags.count( b ) > 0 && player.has_active_mutation( mut ) ) ||
-                ( mut_data.inactive_flags.count( b ) > 0 && !player.has_active_mutation( mut ) ) ) {
+    const auto iter = flag_index.find( b );
+    if( iter == flag_index.end() ) {
+        return false;
+    }
+    if( iter->second.traits > 0 ) {
+        return true;
+    }
+    if( iter->second.toggled_traits == 0 ) {
+        return false;
+    }
+    for( const mutation_branch *mut_data : cached_mutations ) {
+        if( mut_data->activated ) {
+            if( ( mut_data->active_flags.count( b ) > 0 && has_active_mutation( mut_data->id ) ) ||
+                ( mut_data->inactive_flags.count( b ) > 0 && !has_active_mutation( mut_data->id ) ) ) {
                 return true;
             }
         }
@@ -167,8 +172,10 @@ void Character::set_mutations( const std::vector<trait_id> &traits )
         }
         my_mutations.emplace( trait, trait_data{} );
         cached_mutations.push_back( &trait.obj() );
+        add_to_flag_index( flag_index, trait.obj(), 1 );
         mutation_effect( trait, false );
     }
+    invalidate_enchantment_cache();
     recalc_sight_limits();
     calc_encumbrance();
 
@@ -186,6 +193,8 @@ void Character::set_mutation( const trait_id &trait )
     }
     my_mutations.emplace( trait, trait_data{} );
     cached_mutations.push_back( &trait.obj() );
+    add_to_flag_index( flag_index, trait.obj(), 1 );
+    invalidate_enchantment_cache();
     mutation_effect( trait, false );
     recalc_sight_limits();
     calc_encumbrance();
@@ -210,6 +219,8 @@ void Character::unset_mutation( const trait_id &trait_ )
     cached_mutations.erase( std::remove( cached_mutations.begin(), cached_mutations.end(), &mut ),
                             cached_mutations.end() );
     my_mutations.erase( iter );
+    add_to_flag_index( flag_index, mut, -1 );
+    invalidate_enchantment_cache();
     mutation_loss_effect( trait );
     recalc_sight_limits();
     calc_encumbrance();
@@ -649,6 +660,8 @@ void Character::activate_mutation( const trait_id &mut )
                            mdata.name() );
         return;
     }
+    // Every branch below may toggle the mutation, and with it its enchantments
+    invalidate_enchantment_cache();
     if( tdata.powered && tdata.charge > 0 ) {
         // Already-on units just lose a bit of charge
         tdata.charge--;
@@ -807,6 +820,7 @@ void Character::activate_mutation( const trait_id &mut )
 void Character::deactivate_mutation( const trait_id &mut )
 {
     my_mutations[mut].powered = false;
+    invalidate_enchantment_cache();
 
     // Handle stat changes from deactivation
     apply_mods( mut, false );
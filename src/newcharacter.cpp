@@ -3432,6 +3432,7 @@ void Character::clear_mutations()
     while( !my_mutations.empty() ) {
         const trait_id trait = my_mutations.begin()->first;
         my_mutations.erase( my_mutations.begin() );
+        add_to_flag_index( flag_index, trait.obj(), -1 );
         mutation_loss_effect( trait );
     }
     cached_mutations.clear();
@@ -0,0 +1,138 @@
+#include "npc_perception.h"
+
+#include <list>
+#include <memory>
+
+#include "active_item_cache.h"
+#include "character.h"
+#include "creature.h"
+#include "field_type.h"
+#include "game_constants.h"
+#include "item.h"
+#include "item_location.h"
+#include "itype.h"
+#include "iuse.h"
+#include "iuse_actor.h"
+#include "map.h"
+#include "mapdata.h"
+#include "profiler.h"
+
+npc_perception &get_npc_perception()
+{
+    static npc_perception perception;
+    return perception;
+}
+
+npc_perception::turn_scope::turn_scope()
+{
+    npc_perception &p = get_npc_perception();
+    if( p.turn_depth++ == 0 ) {
+        p.invalidate();
+    }
+}
+
+npc_perception::turn_scope::~turn_scope()
+{
+    npc_perception &p = get_npc_perception();
+    if( --p.turn_depth == 0 ) {
+        p.invalidate();
+    }
+}
+
+void npc_perception::invalidate()
+{
+    explosives_valid = false;
+    explosives_cache.clear();
+    fires_valid = false;
+    fires_cache.clear();
+    weapon_value_cache.clear();
+    los_cache.clear();
+}
+
+const std::vector<npc_perception::explosive> &npc_perception::explosives()
+{
+    if( explosives_valid && in_turn() ) {
+        return explosives_cache;
+    }
+    CATA_PROFILE_ZONE( "npc_perception::explosives" );
+    explosives_cache.clear();
+    const map &here = get_map();
+    // A radius spanning the whole map, the z-level is not filtered on.
+    const tripoint center( MAPSIZE_X / 2, MAPSIZE_Y / 2, 0 );
+    for( const item_location &elem : here.get_active_items_in_radius( center, MAPSIZE_X,
+            special_item_type::explosive ) ) {
+        const use_function *use = elem->type->get_use( "explosion" );
+        if( !use ) {
+            continue;
+        }
+        const explosion_iuse *actor = dynamic_cast<const explosion_iuse *>( use->get_actor_ptr() );
+        explosive e;
+        e.pos = elem.position();
+        e.safe_range = actor->explosion.safe_range();
+        e.charges = elem->charges;
+        explosives_cache.push_back( e );
+    }
+    explosives_valid = true;
+    return explosives_cache;
+}
+
+const std::vector<tripoint> &npc_perception::fires( int z )
+{
+    if( fires_valid && fires_z == z && in_turn() ) {
+        return fires_cache;
+    }
+    CATA_PROFILE_ZONE( "npc_perception::fires" );
+    fires_cache.clear();
+    const map &here = get_map();
+    // cache string_id -> int_id conversion before hot loop
+    const field_type_id fd_fire = ::fd_fire;
+    const int mapsize = here.getmapsize();
+    for( int smx = 0; smx < mapsize; ++smx ) {
+        for( int smy = 0; smy < mapsize; ++smy ) {
+            // `map::has_field_at` only tests the per-submap `field_cache` bit
+            if( !here.has_field_at( tripoint( smx * SEEX, smy * SEEY, z ) ) ) {
+                continue;
+            }
+            for( int x = smx * SEEX; x < ( smx + 1 ) * SEEX; ++x ) {
+                for( int y = smy * SEEY; y < ( smy + 1 ) * SEEY; ++y ) {
+                    const tripoint pt( x, y, z );
+                    if( here.get_field( pt, fd_fire ) && !here.has_flag( TFLAG_FIRE_CONTAINER, pt ) ) {
+                        fires_cache.push_back( pt );
+                    }
+                }
+            }
+        }
+    }
+    fires_z = z;
+    fires_valid = true;
+    return fires_cache;
+}
+
+double npc_perception::weapon_value( const Character &guy )
+{
+    if( !in_turn() ) {
+        return guy.weapon_value( guy.weapon );
+    }
+    std::pair<itype_id, double> &entry = weapon_value_cache[&guy];
+    if( entry.first.is_empty() || entry.first != guy.weapon.typeId() ) {
+        entry.first = guy.weapon.typeId();
+        entry.second = guy.weapon_value( guy.weapon );
+    }
+    return entry.second;
+}
+
+bool npc_perception::sees( const Creature &observer, const Creature &target )
+{
+    if( !in_turn() ) {
+        return observer.sees( target );
+    }
+    los_entry &entry = los_cache[std::make_pair( &observer, &target )];
+    if( entry.valid && entry.from == observer.pos() && entry.to == target.pos() ) {
+        return entry.result;
+    }
+    entry.valid = true;
+    entry.from = observer.pos();
+    entry.to = target.pos();
+    entry.result = observer.sees( target );
+    return entry.result;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#ifndef CATA_SRC_NPC_PERCEPTION_H
+#define CATA_SRC_NPC_PERCEPTION_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "hash_utils.h"
+#include "point.h"
+#include "type_id.h"
+
+class Character;
+class Creature;
+
+/**
+ * Facts about the reality bubble that every NPC's danger assessment needs and
+ * that do not depend on who is asking: dangerous explosives, burning tiles,
+ * how well armed each character is and who can see whom.
+ *
+ * While a @ref turn_scope is alive (i.e. while game::monmove moves the NPCs)
+ * the facts are computed once and shared, so a dozen followers do not repeat
+ * the same scans.  Creatures move during that time, so line of sight results
+ * are only reused while both ends stay where they were.  Outside of a turn
+ * scope every query is answered fresh, which keeps ad-hoc callers (dialogue,
+ * tests) from ever seeing stale data.
+ */
+class npc_perception
+{
+    public:
+        struct explosive {
+            tripoint pos;
+            int safe_range = 0;
+            int charges = 0;
+        };
+
+        class turn_scope
+        {
+            public:
+                turn_scope();
+                ~turn_scope();
+
+                turn_scope( const turn_scope & ) = delete;
+                turn_scope &operator=( const turn_scope & ) = delete;
+        };
+
+        bool in_turn() const {
+            return turn_depth > 0;
+        }
+
+        /** Active explosives in the reality bubble. */
+        const std::vector<explosive> &explosives();
+        /** Burning tiles on z-level @p z, excluding fire containers. */
+        const std::vector<tripoint> &fires( int z );
+        /** Character::weapon_value of @p guy's wielded weapon. */
+        double weapon_value( const Character &guy );
+        /** Creature::sees, memoised per observer/target pair. */
+        bool sees( const Creature &observer, const Creature &target );
+
+    private:
+        struct los_entry {
+            bool valid = false;
+            tripoint from;
+            tripoint to;
+            bool result = false;
+        };
+
+        void invalidate();
+
+        int turn_depth = 0;
+
+        bool explosives_valid = false;
+        std::vector<explosive> explosives_cache;
+
+        int fires_z = 0;
+        bool fires_valid = false;
+        std::vector<tripoint> fires_cache;
+
+        // keyed on the weapon type too, in case someone switches weapons mid-turn
+        std::unordered_map<const Character *, std::pair<itype_id, double>> weapon_value_cache;
+        std::unordered_map<std::pair<const Creature *, const Creature *>, los_entry, cata::tuple_hash>
+        los_cache;
+};
+
+npc_perception &get_npc_perception();
+
+#endif // CATA_SRC_NPC_PERCEPTION_H
@@ -52,6 +52,7 @@
 #include "mission.h"
 #include "monster.h"
 #include "mtype.h"
+#include "npc_perception.h"
 #include "npctalk.h"
 #include "omdata.h"
 #include "options.h"
@@ -59,6 +60,7 @@
 #include "overmap_location.h"
 #include "overmapbuffer.h"
 #include "player_activity.h"
+#include "profiler.h"
 #include "projectile.h"
 #include "ranged.h"
 #include "ret_val.h"
@@ -326,30 +328,18 @@ std::vector<sphere> npc::find_dangerous_explosives() const
 {
     std::vector<sphere> result;
 
-    const auto active_items = get_map().get_active_items_in_radius( pos(), MAX_VIEW_DISTANCE,
-                              special_item_type::explosive );
-
-    for( const item_location &elem : active_items ) {
-        const use_function *use = elem->type->get_use( "explosion" );
-
-        if( !use ) {
-            continue;
-        }
-
-        const explosion_iuse *actor = dynamic_cast<const explosion_iuse *>( use->get_actor_ptr() );
-        const int safe_range = actor->explosion.safe_range();
-
-        if( rl_dist( pos(), elem.position() ) >= safe_range ) {
+    for( const npc_perception::explosive &elem : get_npc_perception().explosives() ) {
+        if( rl_dist( pos(), elem.pos ) >= elem.safe_range ) {
             continue;   // Far enough.
         }
 
-        const int turns_to_evacuate = 2 * safe_range / speed_rating();
+        const int turns_to_evacuate = 2 * elem.safe_range / speed_rating();
 
-        if( elem->charges > turns_to_evacuate ) {
+        if( elem.charges > turns_to_evacuate ) {
             continue;   // Consider only imminent dangers.
         }
 
-        result.emplace_back( elem.position(), safe_range );
+        result.emplace_back( elem.pos, elem.safe_range );
     }
 
     return result;
@@ -439,12 +429,10 @@ void npc::assess_danger()
         cur_threat_map[ threat_dir ] = 0.25f * ai_cache.threat_map[ threat_dir ];
     }
     map &here = get_map();
-    // cache string_id -> int_id conversion before hot loop
-    const field_type_id fd_fire = ::fd_fire;
+    npc_perception &perception = get_npc_perception();
     // first, check if we're about to be consumed by fire
-    // `map::get_field` uses `field_cache`, so in general case (no fire) it provides an early exit
-    for( const tripoint &pt : here.points_in_radius( pos(), 6 ) ) {
-        if( pt == pos() || !here.get_field( pt, fd_fire ) || here.has_flag( TFLAG_FIRE_CONTAINER,  pt ) ) {
+    for( const tripoint &pt : perception.fires( posz() ) ) {
+        if( pt == pos() || square_dist( pos(), pt ) > 6 ) {
             continue;
         }
         int dist = rl_dist( pos(), pt );
@@ -493,7 +481,7 @@ void npc::assess_danger()
         if( att != Attitude::HOSTILE && ( critter.friendly || !is_enemy() ) ) {
             continue;
         }
-        if( !sees( critter ) ) {
+        if( !perception.sees( *this, critter ) ) {
             continue;
         }
         float critter_threat = evaluate_enemy( critter );
@@ -662,7 +650,7 @@ float npc::character_danger( const Character &uc ) const
     float ret = 0.0f;
     bool u_gun = u.weapon.is_gun();
     bool my_gun = weapon.is_gun();
-    double u_weap_val = u.weapon_value( u.weapon );
+    double u_weap_val = get_npc_perception().weapon_value( u );
     const double &my_weap_val = ai_cache.my_weapon_value;
     if( u_gun && !my_gun ) {
         u_weap_val *= 1.5f;
@@ -681,6 +669,7 @@ float npc::character_danger( const Character &uc ) const
 
 void npc::regen_ai_cache()
 {
+    CATA_PROFILE_ZONE( "npc::regen_ai_cache" );
     map &here = get_map();
     auto i = std::begin( ai_cache.sound_alerts );
     while( i != std::end( ai_cache.sound_alerts ) ) {
@@ -741,6 +730,7 @@ void npc::regen_ai_cache()
 
 void npc::move()
 {
+    CATA_PROFILE_ZONE( "npc::move" );
     // don't just return from this function without doing something
     // that will eventually subtract moves, or change the NPC to a different type of action.
     // because this will result in an infinite loop
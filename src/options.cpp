@@ -1272,6 +1272,16 @@ void options_manager::add_options_general()
 
     get_option( "AUTOSAVE_MINUTES" ).setPrerequisite( "AUTOSAVE" );
 
+    add( "MAP_MEMORY_BUDGET", "general", to_translation( "Loaded map memory budget" ),
+         to_translation( "Approximate memory, in megabytes, the parts of the world that were loaded may use.  Beyond it, the parts visited least recently are written to the save and unloaded.  0 = unlimited." ),
+         0, 16384, 0
+       );
+
+    add( "OVERMAP_TERRAIN_TABLE", "general", to_translation( "Compact overmap terrain in saves" ),
+         to_translation( "If true, overmaps are saved with a table of the terrain they use, and refer to it by number.  They load faster, but older versions of the game and tools reading the terrain names from the save can't read them." ),
+         false
+       );
+
     add_empty_line();
 
     add( "AUTO_NOTES", "general", to_translation( "Auto notes" ),
@@ -11,6 +11,7 @@
 #include <ostream>
 #include <set>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -26,6 +27,7 @@
 #include "flood_fill.h"
 #include "game.h"
 #include "generic_factory.h"
+#include "hash_utils.h"
 #include "json.h"
 #include "line.h"
 #include "map_iterator.h"
@@ -46,6 +48,7 @@
 #include "overmap_noise.h"
 #include "overmap_types.h"
 #include "overmapbuffer.h"
+#include "profiler.h"
 #include "regional_settings.h"
 #include "rng.h"
 #include "rotatable_symbols.h"
@@ -1051,6 +1054,74 @@ void overmap::populate( overmap_special_batch &enabled_specials )
 }
 
 void overmap::populate()
+{
+    overmap_special_batch enabled_specials = default_specials();
+    populate( enabled_specials );
+}
+
+void overmap::finish_generation()
+{
+    overmap_special_batch enabled_specials = deferred_specials ? *deferred_specials :
+            overmap_special_batch( loc );
+    finish_generation( enabled_specials );
+}
+
+void overmap::finish_generation( overmap_special_batch &enabled_specials )
+{
+    if( !generation_unfinished ) {
+        return;
+    }
+    generation_unfinished = false;
+    place_radios();
+    dbg( D_INFO ) << "overmap::generate done";
+    if( !deferred_specials ) {
+        return;
+    }
+    overmap_special_batch specials = *deferred_specials;
+    deferred_specials.reset();
+    place_specials_on_new_overmap( specials );
+
+    // Clean up...
+    // Because we passed a copy of the specials for placement in adjacent overmaps rather than
+    // the original, but our caller is concerned with whether or not they were placed at all,
+    // regardless of whether we placed them or our callee did, we need to reconcile the placement
+    // that we did of the optional specials with the placement our callee did of optional
+    // and mandatory.
+
+    // Make a lookup of our callee's specials after processing.
+    // Because specials are removed from the list once they meet their maximum
+    // occurrences, this will only contain those which have not yet met their
+    // maximum.
+    std::map<overmap_special_id, int> processed_specials;
+    for( auto &elem : specials ) {
+        processed_specials[elem.special_details->id] = elem.instances_placed;
+    }
+
+    // Loop through the specials we started with.
+    for( auto it = enabled_specials.begin(); it != enabled_specials.end(); ) {
+        // Determine if this special is still in our callee's list of specials...
+        std::map<overmap_special_id, int>::iterator iter = processed_specials.find(
+                    it->special_details->id );
+        if( iter != processed_specials.end() ) {
+            // ... and if so, increment the placement count to reflect the callee's.
+            it->instances_placed += ( iter->second - it->instances_placed );
+
+            // If, after incrementing the placement count, we're at our max, remove
+            // this special from our list.
+            if( it->instances_placed >= it->special_details->occurrences.max ) {
+                it = enabled_specials.erase( it );
+            } else {
+                it++;
+            }
+        } else {
+            // This special is no longer in our callee's list, which means it was completely
+            // placed, and we can remove it from our list.
+            it = enabled_specials.erase( it );
+        }
+    }
+}
+
+overmap_special_batch overmap::default_specials() const
 {
     overmap_special_batch enabled_specials = overmap_specials::get_default_batch( loc );
 
@@ -1094,7 +1165,7 @@ void overmap::populate()
         }
     }
 
-    populate( enabled_specials );
+    return enabled_specials;
 }
 
 oter_id overmap::get_default_terrain( int z ) const
@@ -1122,6 +1193,7 @@ void overmap::init_layers()
                 layer[k].explored[i][j] = false;
             }
         }
+        terrain_indices[k].valid = false;
     }
 }
 
@@ -1133,6 +1205,7 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
     }
 
     layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()] = id;
+    terrain_indices[p.z() + OVERMAP_DEPTH].valid = false;
 }
 
 const oter_id &overmap::ter( const tripoint_om_omt &p ) const
@@ -1145,6 +1218,51 @@ const oter_id &overmap::ter( const tripoint_om_omt &p ) const
     return layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()];
 }
 
+const om_terrain_index &overmap::terrain_index( const int z ) const
+{
+    static_assert( OMAPX * OMAPY <= UINT16_MAX + 1, "overmap squares must fit the index cells" );
+    om_terrain_index &index = terrain_indices[z + OVERMAP_DEPTH];
+    if( index.valid ) {
+        return index;
+    }
+    const map_layer &l = layer[z + OVERMAP_DEPTH];
+    index.runs.clear();
+    index.cells.resize( OMAPX * OMAPY );
+
+    // Count the squares of each terrain, remembering the run of each square
+    std::unordered_map<oter_id, int> run_of;
+    std::vector<int> cell_run( OMAPX * OMAPY );
+    oter_id last_id = ot_null;
+    int last_run = -1;
+    for( int y = 0; y < OMAPY; ++y ) {
+        for( int x = 0; x < OMAPX; ++x ) {
+            const oter_id &id = l.terrain[x][y];
+            if( last_run < 0 || id != last_id ) {
+                const auto iter = run_of.emplace( id, static_cast<int>( index.runs.size() ) );
+                if( iter.second ) {
+                    index.runs.push_back( { id, 0, 0 } );
+                }
+                last_id = id;
+                last_run = iter.first->second;
+            }
+            cell_run[x + y * OMAPX] = last_run;
+            index.runs[last_run].end++;
+        }
+    }
+    int begin = 0;
+    for( om_terrain_index::run &r : index.runs ) {
+        const int count = r.end;
+        r.begin = begin;
+        r.end = begin;
+        begin += count;
+    }
+    for( int cell = 0; cell < OMAPX * OMAPY; ++cell ) {
+        index.cells[index.runs[cell_run[cell]].end++] = static_cast<uint16_t>( cell );
+    }
+    index.valid = true;
+    return index;
+}
+
 bool &overmap::seen( const tripoint_om_omt &p )
 {
     if( !inbounds( p ) ) {
@@ -1443,29 +1561,34 @@ void overmap::set_scent( const tripoint_abs_omt &loc, const scent_trace &new_sce
     scents[loc] = new_scent;
 }
 
-void overmap::generate( const overmap *north, const overmap *east,
-                        const overmap *south, const overmap *west,
-                        overmap_special_batch &enabled_specials )
+static unsigned int generation_seed( const point_abs_om &p, unsigned int world_seed )
 {
-    if( g->gametype() == special_game_type::DEFENSE ) {
-        dbg( D_INFO ) << "overmap::generate skipped in Defense special game mode!";
-        return;
-    }
+    size_t seed = world_seed;
+    cata::hash_combine( seed, p.x() );
+    cata::hash_combine( seed, p.y() );
+    return static_cast<unsigned int>( seed );
+}
 
-    dbg( D_INFO ) << "overmap::generate start…";
+void overmap::generate( const om_generation_inputs &inputs,
+                        overmap_special_batch &enabled_specials )
+{
+    CATA_PROFILE_ZONE( "overmap::generate" );
+    // Seeded by position, so the result only depends on the world and the neighbours,
+    // not on when (or on which thread) the overmap is generated.
+    const rng_seed_scope seeded( generation_seed( loc, inputs.seed ) );
 
-    populate_connections_out_from_neighbors( north, east, south, west );
+    populate_connections_out_from_neighbors( inputs );
 
-    place_rivers( north, east, south, west );
-    place_lakes();
-    place_forests();
-    place_swamps();
+    place_rivers( inputs );
+    place_lakes( inputs );
+    place_forests( inputs );
+    place_swamps( inputs );
     place_ravines();
-    place_cities();
+    place_cities( inputs );
     place_forest_trails();
-    place_roads( north, east, south, west );
+    place_roads( inputs );
     place_specials( enabled_specials );
-    place_forest_trailheads();
+    place_forest_trailheads( inputs );
 
     polish_river();
 
@@ -1487,9 +1610,8 @@ void overmap::generate( const overmap *north, const overmap *east,
     } while( requires_over && ( ++z <= OVERMAP_HEIGHT ) );
 
     // Place the monsters, now that the terrain is laid out
-    place_mongroups();
-    place_radios();
-    dbg( D_INFO ) << "overmap::generate done";
+    place_mongroups( inputs );
+    generation_unfinished = true;
 }
 
 bool overmap::generate_sub( const int z )
@@ -2134,51 +2256,59 @@ void overmap::signal_hordes( const tripoint_rel_sm &p_rel, const int sig_power )
     }
 }
 
-void overmap::populate_connections_out_from_neighbors( const overmap *north, const overmap *east,
-        const overmap *south, const overmap *west )
+om_edge overmap::edge_towards( om_direction::type dir ) const
 {
-    const auto populate_for_side =
-        [&]( const overmap * adjacent,
-             const std::function<bool( const tripoint_om_omt & )> &should_include,
-    const std::function<tripoint_om_omt( const tripoint_om_omt & )> &build_point ) {
-        if( adjacent == nullptr ) {
-            return;
+    // The squares along the edge, and where they are on the neighbour
+    const auto edge_point = [dir]( int i ) {
+        switch( dir ) {
+            case om_direction::type::north:
+                return std::make_pair( tripoint_om_omt( i, 0, 0 ), tripoint_om_omt( i, OMAPY - 1, 0 ) );
+            case om_direction::type::east:
+                return std::make_pair( tripoint_om_omt( OMAPX - 1, i, 0 ), tripoint_om_omt( 0, i, 0 ) );
+            case om_direction::type::south:
+                return std::make_pair( tripoint_om_omt( i, OMAPY - 1, 0 ), tripoint_om_omt( i, 0, 0 ) );
+            case om_direction::type::west:
+            default:
+                return std::make_pair( tripoint_om_omt( 0, i, 0 ), tripoint_om_omt( OMAPX - 1, i, 0 ) );
         }
+    };
+    const bool along_x = dir == om_direction::type::north || dir == om_direction::type::south;
+
+    om_edge edge;
+    for( int i = 0; i < OMAPX; ++i ) {
+        edge.ter[i] = ter( edge_point( i ).first );
+    }
+    for( const std::pair<const string_id<overmap_connection>, std::vector<tripoint_om_omt>> &kv :
+         connections_out ) {
+        std::vector<tripoint_om_omt> &out = edge.connections_out[kv.first];
+        for( const tripoint_om_omt &p : kv.second ) {
+            const int i = along_x ? p.x() : p.y();
+            const std::pair<tripoint_om_omt, tripoint_om_omt> ends = edge_point( i );
+            if( p.xy() == ends.first.xy() ) {
+                out.push_back( tripoint_om_omt( ends.second.xy(), p.z() ) );
+            }
+        }
+    }
+    return edge;
+}
 
+void overmap::populate_connections_out_from_neighbors( const om_generation_inputs &inputs )
+{
+    // In the order they were always merged in
+    for( const om_direction::type dir : {
+             om_direction::type::north, om_direction::type::west,
+             om_direction::type::south, om_direction::type::east
+         } ) {
+        const cata::optional<om_edge> &adjacent = inputs.neighbours[static_cast<int>( dir )];
+        if( !adjacent ) {
+            continue;
+        }
         for( const std::pair<const string_id<overmap_connection>, std::vector<tripoint_om_omt>> &kv :
              adjacent->connections_out ) {
             std::vector<tripoint_om_omt> &out = connections_out[kv.first];
-            const auto adjacent_out = adjacent->connections_out.find( kv.first );
-            if( adjacent_out != adjacent->connections_out.end() ) {
-                for( const tripoint_om_omt &p : adjacent_out->second ) {
-                    if( should_include( p ) ) {
-                        out.push_back( build_point( p ) );
-                    }
-                }
-            }
+            out.insert( out.end(), kv.second.begin(), kv.second.end() );
         }
-    };
-
-    populate_for_side( north, []( const tripoint_om_omt & p ) {
-        return p.y() == OMAPY - 1;
-    }, []( const tripoint_om_omt & p ) {
-        return tripoint_om_omt( p.x(), 0, p.z() );
-    } );
-    populate_for_side( west, []( const tripoint_om_omt & p ) {
-        return p.x() == OMAPX - 1;
-    }, []( const tripoint_om_omt & p ) {
-        return tripoint_om_omt( 0, p.y(), p.z() );
-    } );
-    populate_for_side( south, []( const tripoint_om_omt & p ) {
-        return p.y() == 0;
-    }, []( const tripoint_om_omt & p ) {
-        return tripoint_om_omt( p.x(), OMAPY - 1, p.z() );
-    } );
-    populate_for_side( east, []( const tripoint_om_omt & p ) {
-        return p.x() == 0;
-    }, []( const tripoint_om_omt & p ) {
-        return tripoint_om_omt( OMAPX - 1, p.y(), p.z() );
-    } );
+    }
 }
 
 void overmap::place_forest_trails()
@@ -2304,11 +2434,10 @@ void overmap::place_forest_trails()
     }
 }
 
-void overmap::place_forest_trailheads()
+void overmap::place_forest_trailheads( const om_generation_inputs &inputs )
 {
     // No trailheads if there are no cities.
-    const int city_size = get_option<int>( "CITY_SIZE" );
-    if( city_size <= 0 ) {
+    if( inputs.city_size <= 0 ) {
         return;
     }
 
@@ -2354,13 +2483,14 @@ void overmap::place_forest_trailheads()
     }
 }
 
-void overmap::place_forests()
+void overmap::place_forests( const om_generation_inputs &inputs )
 {
     const oter_id default_oter_id( settings.default_oter );
     const oter_id forest( "forest" );
     const oter_id forest_thick( "forest_thick" );
 
-    const om_noise::om_noise_layer_forest f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_layer_forest noise( global_base_point(), inputs.seed );
+    const om_noise::om_noise_grid f( noise );
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
@@ -2385,9 +2515,10 @@ void overmap::place_forests()
     }
 }
 
-void overmap::place_lakes()
+void overmap::place_lakes( const om_generation_inputs &inputs )
 {
-    const om_noise::om_noise_layer_lake f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_layer_lake noise( global_base_point(), inputs.seed );
+    const om_noise::om_noise_grid f( noise );
 
     const auto is_lake = [&]( const point_om_omt & p ) {
         return f.noise_at( p ) > settings.overmap_lake.noise_threshold_lake;
@@ -2522,12 +2653,19 @@ void overmap::place_lakes()
     }
 }
 
-void overmap::place_rivers( const overmap *north, const overmap *east, const overmap *south,
-                            const overmap *west )
+void overmap::place_rivers( const om_generation_inputs &inputs )
 {
     if( settings.river_scale == 0.0 ) {
         return;
     }
+    const cata::optional<om_edge> &north = inputs.neighbours[static_cast<int>
+                                           ( om_direction::type::north )];
+    const cata::optional<om_edge> &east = inputs.neighbours[static_cast<int>
+                                          ( om_direction::type::east )];
+    const cata::optional<om_edge> &south = inputs.neighbours[static_cast<int>
+                                           ( om_direction::type::south )];
+    const cata::optional<om_edge> &west = inputs.neighbours[static_cast<int>
+                                          ( om_direction::type::west )];
     int river_chance = static_cast<int>( std::max( 1.0, 1.0 / settings.river_scale ) );
     int river_scale = static_cast<int>( std::max( 1.0, settings.river_scale ) );
     // West/North endpoints of rivers
@@ -2539,17 +2677,16 @@ void overmap::place_rivers( const overmap *north, const overmap *east, const ove
     // optimized comparison.
     const oter_id river_center( "river_center" );
 
-    if( north != nullptr ) {
+    if( north ) {
         for( int i = 2; i < OMAPX - 2; i++ ) {
-            const tripoint_om_omt p_neighbour( i, OMAPY - 1, 0 );
             const tripoint_om_omt p_mine( i, 0, 0 );
 
-            if( is_river( north->ter( p_neighbour ) ) ) {
+            if( is_river( north->ter[i] ) ) {
                 ter_set( p_mine, river_center );
             }
-            if( is_river( north->ter( p_neighbour ) ) &&
-                is_river( north->ter( p_neighbour + point_east ) ) &&
-                is_river( north->ter( p_neighbour + point_west ) ) ) {
+            if( is_river( north->ter[i] ) &&
+                is_river( north->ter[i + 1] ) &&
+                is_river( north->ter[i - 1] ) ) {
                 if( one_in( river_chance ) && ( river_start.empty() ||
                                                 river_start[river_start.size() - 1].x() < ( i - 6 ) * river_scale ) ) {
                     river_start.push_back( p_mine.xy() );
@@ -2558,17 +2695,16 @@ void overmap::place_rivers( const overmap *north, const overmap *east, const ove
         }
     }
     size_t rivers_from_north = river_start.size();
-    if( west != nullptr ) {
+    if( west ) {
         for( int i = 2; i < OMAPY - 2; i++ ) {
-            const tripoint_om_omt p_neighbour( OMAPX - 1, i, 0 );
             const tripoint_om_omt p_mine( 0, i, 0 );
 
-            if( is_river( west->ter( p_neighbour ) ) ) {
+            if( is_river( west->ter[i] ) ) {
                 ter_set( p_mine, river_center );
             }
-            if( is_river( west->ter( p_neighbour ) ) &&
-                is_river( west->ter( p_neighbour + point_north ) ) &&
-                is_river( west->ter( p_neighbour + point_south ) ) ) {
+            if( is_river( west->ter[i] ) &&
+                is_river( west->ter[i - 1] ) &&
+                is_river( west->ter[i + 1] ) ) {
                 if( one_in( river_chance ) && ( river_start.size() == rivers_from_north ||
                                                 river_start[river_start.size() - 1].y() < ( i - 6 ) * river_scale ) ) {
                     river_start.push_back( p_mine.xy() );
@@ -2576,17 +2712,16 @@ void overmap::place_rivers( const overmap *north, const overmap *east, const ove
             }
         }
     }
-    if( south != nullptr ) {
+    if( south ) {
         for( int i = 2; i < OMAPX - 2; i++ ) {
-            const tripoint_om_omt p_neighbour( i, 0, 0 );
             const tripoint_om_omt p_mine( i, OMAPY - 1, 0 );
 
-            if( is_river( south->ter( p_neighbour ) ) ) {
+            if( is_river( south->ter[i] ) ) {
                 ter_set( p_mine, river_center );
             }
-            if( is_river( south->ter( p_neighbour ) ) &&
-                is_river( south->ter( p_neighbour + point_east ) ) &&
-                is_river( south->ter( p_neighbour + point_west ) ) ) {
+            if( is_river( south->ter[i] ) &&
+                is_river( south->ter[i + 1] ) &&
+                is_river( south->ter[i - 1] ) ) {
                 if( river_end.empty() ||
                     river_end[river_end.size() - 1].x() < i - 6 ) {
                     river_end.push_back( p_mine.xy() );
@@ -2595,17 +2730,16 @@ void overmap::place_rivers( const overmap *north, const overmap *east, const ove
         }
     }
     size_t rivers_to_south = river_end.size();
-    if( east != nullptr ) {
+    if( east ) {
         for( int i = 2; i < OMAPY - 2; i++ ) {
-            const tripoint_om_omt p_neighbour( 0, i, 0 );
             const tripoint_om_omt p_mine( OMAPX - 1, i, 0 );
 
-            if( is_river( east->ter( p_neighbour ) ) ) {
+            if( is_river( east->ter[i] ) ) {
                 ter_set( p_mine, river_center );
             }
-            if( is_river( east->ter( p_neighbour ) ) &&
-                is_river( east->ter( p_neighbour + point_north ) ) &&
-                is_river( east->ter( p_neighbour + point_south ) ) ) {
+            if( is_river( east->ter[i] ) &&
+                is_river( east->ter[i - 1] ) &&
+                is_river( east->ter[i + 1] ) ) {
                 if( river_end.size() == rivers_to_south ||
                     river_end[river_end.size() - 1].y() < i - 6 ) {
                     river_end.push_back( p_mine.xy() );
@@ -2617,25 +2751,25 @@ void overmap::place_rivers( const overmap *north, const overmap *east, const ove
     // Even up the start and end points of rivers. (difference of 1 is acceptable)
     // Also ensure there's at least one of each.
     std::vector<point_om_omt> new_rivers;
-    if( north == nullptr || west == nullptr ) {
+    if( !north || !west ) {
         while( river_start.empty() || river_start.size() + 1 < river_end.size() ) {
             new_rivers.clear();
-            if( north == nullptr && one_in( river_chance ) ) {
+            if( !north && one_in( river_chance ) ) {
                 new_rivers.push_back( point_om_omt( rng( 10, OMAPX - 11 ), 0 ) );
             }
-            if( west == nullptr && one_in( river_chance ) ) {
+            if( !west && one_in( river_chance ) ) {
                 new_rivers.push_back( point_om_omt( 0, rng( 10, OMAPY - 11 ) ) );
             }
             river_start.push_back( random_entry( new_rivers ) );
         }
     }
-    if( south == nullptr || east == nullptr ) {
+    if( !south || !east ) {
         while( river_end.empty() || river_end.size() + 1 < river_start.size() ) {
             new_rivers.clear();
-            if( south == nullptr && one_in( river_chance ) ) {
+            if( !south && one_in( river_chance ) ) {
                 new_rivers.push_back( point_om_omt( rng( 10, OMAPX - 11 ), OMAPY - 1 ) );
             }
-            if( east == nullptr && one_in( river_chance ) ) {
+            if( !east && one_in( river_chance ) ) {
                 new_rivers.push_back( point_om_omt( OMAPX - 1, rng( 10, OMAPY - 11 ) ) );
             }
             river_end.push_back( random_entry( new_rivers ) );
@@ -2676,7 +2810,7 @@ void overmap::place_rivers( const overmap *north, const overmap *east, const ove
     }
 }
 
-void overmap::place_swamps()
+void overmap::place_swamps( const om_generation_inputs &inputs )
 {
     // Buffer our river terrains by a variable radius and increment a counter for the location each
     // time it's included in a buffer. It's a floodplain that we'll then intersect later with some
@@ -2704,7 +2838,8 @@ void overmap::place_swamps()
     const oter_id forest_water( "forest_water" );
 
     // Get a layer of noise to use in conjunction with our river buffered floodplain.
-    const om_noise::om_noise_layer_floodplain f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_layer_floodplain noise( global_base_point(), inputs.seed );
+    const om_noise::om_noise_grid f( noise );
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
@@ -2731,9 +2866,11 @@ void overmap::place_swamps()
     }
 }
 
-void overmap::place_roads( const overmap *north, const overmap *east, const overmap *south,
-                           const overmap *west )
+void overmap::place_roads( const om_generation_inputs &inputs )
 {
+    const auto has_neighbour = [&inputs]( om_direction::type dir ) {
+        return static_cast<bool>( inputs.neighbours[static_cast<int>( dir )] );
+    };
     const string_id<overmap_connection> local_road( "local_road" );
     std::vector<tripoint_om_omt> &roads_out = connections_out[local_road];
 
@@ -2749,7 +2886,7 @@ void overmap::place_roads( const overmap *north, const overmap *east, const over
             omap_num[i] = i + 10;
         }
 
-        if( north == nullptr ) {
+        if( !has_neighbour( om_direction::type::north ) ) {
             std::shuffle( omap_num.begin(), omap_num.end(), rng_get_engine() );
             for( const auto &i : omap_num ) {
                 tmp = tripoint_om_omt( i, 0, 0 );
@@ -2760,7 +2897,7 @@ void overmap::place_roads( const overmap *north, const overmap *east, const over
                 }
             }
         }
-        if( east == nullptr ) {
+        if( !has_neighbour( om_direction::type::east ) ) {
             std::shuffle( omap_num.begin(), omap_num.end(), rng_get_engine() );
             for( const auto &i : omap_num ) {
                 tmp = tripoint_om_omt( OMAPX - 1, i, 0 );
@@ -2771,7 +2908,7 @@ void overmap::place_roads( const overmap *north, const overmap *east, const over
                 }
             }
         }
-        if( south == nullptr ) {
+        if( !has_neighbour( om_direction::type::south ) ) {
             std::shuffle( omap_num.begin(), omap_num.end(), rng_get_engine() );
             for( const auto &i : omap_num ) {
                 tmp = tripoint_om_omt( i, OMAPY - 1, 0 );
@@ -2782,7 +2919,7 @@ void overmap::place_roads( const overmap *north, const overmap *east, const over
                 }
             }
         }
-        if( west == nullptr ) {
+        if( !has_neighbour( om_direction::type::west ) ) {
             std::shuffle( omap_num.begin(), omap_num.end(), rng_get_engine() );
             for( const auto &i : omap_num ) {
                 tmp = tripoint_om_omt( 0, i, 0 );
@@ -2907,13 +3044,13 @@ void overmap::place_river( const point_om_omt &pa, const point_om_omt &pb )
 
 spawns happen at... <cue Clue music>
 20:56 <kevingranade>: game:pawn_mon() in game.cpp:7380*/
-void overmap::place_cities()
+void overmap::place_cities( const om_generation_inputs &inputs )
 {
-    int op_city_size = get_option<int>( "CITY_SIZE" );
+    int op_city_size = inputs.city_size;
     if( op_city_size <= 0 ) {
         return;
     }
-    int op_city_spacing = get_option<int>( "CITY_SPACING" );
+    int op_city_spacing = inputs.city_spacing;
 
     // spacing dictates how much of the map is covered in cities
     //   city  |  cities  |   size N cities per overmap
@@ -3771,6 +3908,15 @@ bool overmap::check_ot( const std::string &otype, ot_match_type match_type,
     return is_ot_match( otype, oter, match_type );
 }
 
+cata::optional<overmap_special_id> overmap::overmap_special_at( const tripoint_om_omt &p ) const
+{
+    const auto found = overmap_special_placements.find( p );
+    if( found == overmap_special_placements.end() ) {
+        return cata::nullopt;
+    }
+    return found->second;
+}
+
 bool overmap::check_overmap_special_type( const overmap_special_id &id,
         const tripoint_om_omt &location ) const
 {
@@ -4277,9 +4423,18 @@ void overmap::place_specials( overmap_special_batch &enabled_specials )
     // specials to place here.
     overmap_special_batch custom_overmap_specials = overmap_special_batch( enabled_specials );
 
+    // Placing those on adjacent overmaps waits until this one is complete and
+    // in the overmap buffer, see place_deferred_specials.
+    deferred_specials.emplace( custom_overmap_specials );
+    // Then fill in non-mandatory specials.
+    place_specials_pass( enabled_specials, sectors, true, false );
+}
+
+void overmap::place_specials_on_new_overmap( overmap_special_batch &specials )
+{
     // Check for any unplaced mandatory specials, and if there are any, attempt to
     // place them on adjacent uncreated overmaps.
-    if( std::any_of( custom_overmap_specials.begin(), custom_overmap_specials.end(),
+    if( std::any_of( specials.begin(), specials.end(),
     []( overmap_special_placement placement ) {
     return placement.instances_placed <
            placement.special_details->occurrences.min;
@@ -4290,7 +4445,7 @@ void overmap::place_specials( overmap_special_batch &enabled_specials )
         // Since this starts at enabled_specials::origin, it will only place new overmaps
         // in the 5x5 area surrounding the initial overmap, bounding the amount of work we will do.
         for( const point_abs_om &candidate_addr : closest_points_first(
-                 custom_overmap_specials.get_origin(), 2 ) ) {
+                 specials.get_origin(), 2 ) ) {
             if( !overmap_buffer.has( candidate_addr ) ) {
                 int current_distance = square_dist( pos(), candidate_addr );
                 if( nearest_candidates.empty() || current_distance == previous_distance ) {
@@ -4304,59 +4459,18 @@ void overmap::place_specials( overmap_special_batch &enabled_specials )
         if( !nearest_candidates.empty() ) {
             std::shuffle( nearest_candidates.begin(), nearest_candidates.end(), rng_get_engine() );
             point_abs_om new_om_addr = nearest_candidates.front();
-            overmap_buffer.create_custom_overmap( new_om_addr, custom_overmap_specials );
+            overmap_buffer.create_custom_overmap( new_om_addr, specials );
         } else {
             add_msg( _( "Unable to place all configured specials, some missions may fail to initialize." ) );
         }
     }
-    // Then fill in non-mandatory specials.
-    place_specials_pass( enabled_specials, sectors, true, false );
-
-    // Clean up...
-    // Because we passed a copy of the specials for placement in adjacent overmaps rather than
-    // the original, but our caller is concerned with whether or not they were placed at all,
-    // regardless of whether we placed them or our callee did, we need to reconcile the placement
-    // that we did of the optional specials with the placement our callee did of optional
-    // and mandatory.
-
-    // Make a lookup of our callee's specials after processing.
-    // Because specials are removed from the list once they meet their maximum
-    // occurrences, this will only contain those which have not yet met their
-    // maximum.
-    std::map<overmap_special_id, int> processed_specials;
-    for( auto &elem : custom_overmap_specials ) {
-        processed_specials[elem.special_details->id] = elem.instances_placed;
-    }
-
-    // Loop through the specials we started with.
-    for( auto it = enabled_specials.begin(); it != enabled_specials.end(); ) {
-        // Determine if this special is still in our callee's list of specials...
-        std::map<overmap_special_id, int>::iterator iter = processed_specials.find(
-                    it->special_details->id );
-        if( iter != processed_specials.end() ) {
-            // ... and if so, increment the placement count to reflect the callee's.
-            it->instances_placed += ( iter->second - it->instances_placed );
-
-            // If, after incrementing the placement count, we're at our max, remove
-            // this special from our list.
-            if( it->instances_placed >= it->special_details->occurrences.max ) {
-                it = enabled_specials.erase( it );
-            } else {
-                it++;
-            }
-        } else {
-            // This special is no longer in our callee's list, which means it was completely
-            // placed, and we can remove it from our list.
-            it = enabled_specials.erase( it );
-        }
-    }
 }
 
-void overmap::place_mongroups()
+void overmap::place_mongroups( const om_generation_inputs &inputs )
 {
     // Cities are full of zombies
     for( city &elem : cities ) {
-        if( get_option<bool>( "WANDER_SPAWNS" ) ) {
+        if( inputs.wander_spawns ) {
             if( !one_in( 16 ) || elem.size > 5 ) {
                 mongroup m( GROUP_ZOMBIE,
                             tripoint_om_sm( project_to<coords::sm>( elem.pos ), 0 ),
@@ -4370,7 +4484,7 @@ void overmap::place_mongroups()
         }
     }
 
-    if( get_option<bool>( "DISABLE_ANIMAL_CLASH" ) ) {
+    if( inputs.disable_animal_clash ) {
         // Figure out where swamps are, and place swamp monsters
         for( int x = 3; x < OMAPX - 3; x += 7 ) {
             for( int y = 3; y < OMAPY - 3; y += 7 ) {
@@ -4457,25 +4571,18 @@ void overmap::place_radios()
 
 void overmap::open( overmap_special_batch &enabled_specials )
 {
+    CATA_PROFILE_ZONE( "overmap::open" );
     const std::string terfilename = overmapbuffer::terrain_filename( loc );
 
     using namespace std::placeholders;
     if( read_from_file_optional( terfilename, std::bind( &overmap::unserialize, this, _1 ) ) ) {
         const std::string plrfilename = overmapbuffer::player_filename( loc );
         read_from_file_optional( plrfilename, std::bind( &overmap::unserialize_view, this, _1 ) );
+    } else if( g->gametype() == special_game_type::DEFENSE ) {
+        dbg( D_INFO ) << "overmap::generate skipped in Defense special game mode!";
     } else { // No map exists!  Prepare neighbors, and generate one.
-        std::vector<const overmap *> pointers;
-        // Fetch south and north
-        for( int i = -1; i <= 1; i += 2 ) {
-            pointers.push_back( overmap_buffer.get_existing( loc + point( 0, i ) ) );
-        }
-        // Fetch east and west
-        for( int i = -1; i <= 1; i += 2 ) {
-            pointers.push_back( overmap_buffer.get_existing( loc + point( i, 0 ) ) );
-        }
-
-        // pointers looks like (north, south, west, east)
-        generate( pointers[0], pointers[3], pointers[1], pointers[2], enabled_specials );
+        dbg( D_INFO ) << "overmap::generate start…";
+        generate( overmap_buffer.generation_inputs( loc ), enabled_specials );
     }
 }
 
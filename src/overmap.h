@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <iosfwd>
@@ -107,11 +108,59 @@ struct map_layer {
     std::vector<om_map_extra> extras;
 };
 
+/**
+ * The squares of an overmap layer grouped by terrain, so a search for a terrain only looks at
+ * the squares that have it.  See overmap::terrain_index.
+ */
+struct om_terrain_index {
+    struct run {
+        oter_id id;
+        // The squares with the terrain are cells[begin] to cells[end - 1]
+        int begin;
+        int end;
+    };
+    std::vector<run> runs;
+    // Squares as x + y * OMAPX
+    std::vector<uint16_t> cells;
+    bool valid = false;
+
+    point_om_omt cell_point( int i ) const {
+        return point_om_omt( cells[i] % OMAPX, cells[i] / OMAPX );
+    }
+};
+
 struct om_special_sectors {
     std::vector<point_om_omt> sectors;
     int sector_width;
 };
 
+/**
+ * What generating an overmap reads from an existing neighbour: the ground level terrain along
+ * their shared edge and the connections that leave the neighbour through it.
+ */
+struct om_edge {
+    // Indexed by x for a neighbour to the north or south, by y for one to the east or west
+    std::array<oter_id, OMAPX> ter;
+    // Already moved to the matching squares on the border of the new overmap
+    std::map<string_id<overmap_connection>, std::vector<tripoint_om_omt>> connections_out;
+};
+static_assert( OMAPX == OMAPY, "om_edge assumes square overmaps" );
+
+/**
+ * Everything generating an overmap reads from outside of it, gathered on the main thread by
+ * overmapbuffer::generation_inputs so that the generation itself can run on another thread.
+ */
+struct om_generation_inputs {
+    // The world seed
+    unsigned int seed = 0;
+    int city_size = 0;
+    int city_spacing = 0;
+    bool wander_spawns = false;
+    bool disable_animal_clash = false;
+    // Edges of the existing neighbours, indexed by om_direction::type
+    std::array<cata::optional<om_edge>, 4> neighbours;
+};
+
 // Wrapper around an overmap special to track progress of placing specials.
 struct overmap_special_placement {
     int instances_placed;
@@ -207,10 +256,28 @@ class overmap
         overmap &operator=( const overmap & ) = default;
 
         /**
-         * Create content in the overmap.
+         * Create content in the overmap.  A generated overmap still needs
+         * @ref finish_generation.
          **/
         void populate( overmap_special_batch &enabled_specials );
         void populate();
+        /**
+         * Generate content for this new overmap.  Reads nothing outside of this overmap but
+         * @p inputs and the game data, so it can run on another thread as long as that thread
+         * turned off the string id cache (see string_id_cache_enabled).
+         */
+        void generate( const om_generation_inputs &inputs, overmap_special_batch &enabled_specials );
+        /**
+         * The part of generating this overmap that has to happen on the main thread, once the
+         * overmap is in the buffer: radio towers, whose messages come from the snippets, and the
+         * mandatory specials that did not fit, which go on new adjacent overmaps.  The overload
+         * updates the placement counts of @p enabled_specials, the batch this overmap was
+         * generated with, to include the adjacent overmaps.  Does nothing for loaded overmaps.
+         */
+        void finish_generation();
+        void finish_generation( overmap_special_batch &enabled_specials );
+        /** The edge of this overmap facing its neighbour in direction @p dir, see om_edge. */
+        om_edge edge_towards( om_direction::type dir ) const;
 
         const point_abs_om &pos() const {
             return loc;
@@ -238,6 +305,11 @@ class overmap
 
         void ter_set( const tripoint_om_omt &p, const oter_id &id );
         const oter_id &ter( const tripoint_om_omt &p ) const;
+        /**
+         * The squares of z-level @p z grouped by terrain.  Built when first asked for, and again
+         * after the terrain of the level changed.
+         */
+        const om_terrain_index &terrain_index( int z ) const;
         bool &seen( const tripoint_om_omt &p );
         bool seen( const tripoint_om_omt &p ) const;
         bool &explored( const tripoint_om_omt &p );
@@ -250,6 +322,9 @@ class overmap
         void delete_note( const tripoint_om_omt &p );
         void mark_note_dangerous( const tripoint_om_omt &p, int radius, bool is_dangerous );
 
+        /** The special placed at @p p, if any. */
+        cata::optional<overmap_special_id> overmap_special_at( const tripoint_om_omt &p ) const;
+
         bool has_extra( const tripoint_om_omt &p ) const;
         const string_id<map_extra> &extra( const tripoint_om_omt &p ) const;
         void add_extra( const tripoint_om_omt &p, const string_id<map_extra> &id );
@@ -353,6 +428,8 @@ class overmap
         point_abs_om loc;
 
         std::array<map_layer, OVERMAP_LAYERS> layer;
+        // mutable, as they are built on demand, see terrain_index
+        mutable std::array<om_terrain_index, OVERMAP_LAYERS> terrain_indices;
         std::unordered_map<tripoint_abs_omt, scent_trace> scents;
 
         // Records the locations where a given overmap special was placed, which
@@ -362,6 +439,11 @@ class overmap
 
         regional_settings settings;
 
+        // Set by generate until finish_generation has run
+        bool generation_unfinished = false;
+        // Mandatory specials left over by generate, see finish_generation
+        cata::optional<overmap_special_batch> deferred_specials;
+
         oter_id get_default_terrain( int z ) const;
 
         // Initialize
@@ -387,9 +469,6 @@ class overmap
         // Save per-player overmap view data.
         void serialize_view( std::ostream &fout ) const;
     private:
-        void generate( const overmap *north, const overmap *east,
-                       const overmap *south, const overmap *west,
-                       overmap_special_batch &enabled_specials );
         bool generate_sub( int z );
         bool generate_over( int z );
         // Check and put bridgeheads
@@ -407,24 +486,21 @@ class overmap
 
         // Overall terrain
         void place_river( const point_om_omt &pa, const point_om_omt &pb );
-        void place_forests();
-        void place_lakes();
-        void place_rivers( const overmap *north, const overmap *east, const overmap *south,
-                           const overmap *west );
-        void place_swamps();
+        void place_forests( const om_generation_inputs &inputs );
+        void place_lakes( const om_generation_inputs &inputs );
+        void place_rivers( const om_generation_inputs &inputs );
+        void place_swamps( const om_generation_inputs &inputs );
         void place_forest_trails();
-        void place_forest_trailheads();
+        void place_forest_trailheads( const om_generation_inputs &inputs );
 
-        void place_roads( const overmap *north, const overmap *east, const overmap *south,
-                          const overmap *west );
+        void place_roads( const om_generation_inputs &inputs );
 
-        void populate_connections_out_from_neighbors( const overmap *north, const overmap *east,
-                const overmap *south, const overmap *west );
+        void populate_connections_out_from_neighbors( const om_generation_inputs &inputs );
 
         // City Building
         overmap_special_id pick_random_building_to_place( int town_dist ) const;
 
-        void place_cities();
+        void place_cities( const om_generation_inputs &inputs );
         void place_building( const tripoint_om_omt &p, om_direction::type dir, const city &town );
 
         void build_city_street( const overmap_connection &connection, const point_om_omt &p, int cs,
@@ -479,6 +555,13 @@ class overmap
          * @param enabled_specials specifies what specials to place, and tracks how many have been placed.
          **/
         void place_specials( overmap_special_batch &enabled_specials );
+        /**
+         * Create a new overmap nearby to place the mandatory specials of @p specials
+         * that have not met their minimum count yet, if there are any.
+         **/
+        void place_specials_on_new_overmap( overmap_special_batch &specials );
+        /** The specials enabled by default, filtered by the regional settings. */
+        overmap_special_batch default_specials() const;
         /**
          * Walk over the overmap and attempt to place specials.
          * @param enabled_specials vector of objects that track specials being placed.
@@ -498,7 +581,7 @@ class overmap
             overmap_special_batch &enabled_specials, const point_om_omt &sector, int sector_width,
             bool place_optional, bool must_be_unexplored );
 
-        void place_mongroups();
+        void place_mongroups( const om_generation_inputs &inputs );
         void place_radios();
 
         void add_mon_group( const mongroup &group );
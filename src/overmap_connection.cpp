@@ -71,24 +71,9 @@ const overmap_connection::subtype *overmap_connection::pick_subtype_for(
         return nullptr;
     }
 
-    const size_t cache_index = ground.to_i();
-    cata_assert( cache_index < cached_subtypes.size() );
-
-    if( cached_subtypes[cache_index] ) {
-        return cached_subtypes[cache_index].value;
-    }
-
-    const auto iter = std::find_if( subtypes.cbegin(),
-    subtypes.cend(), [&ground]( const subtype & elem ) {
-        return elem.allows_terrain( ground );
-    } );
-
-    const overmap_connection::subtype *result = iter != subtypes.cend() ? &*iter : nullptr;
-
-    cached_subtypes[cache_index].value = result;
-    cached_subtypes[cache_index].assigned = true;
-
-    return result;
+    const size_t index = ground.to_i();
+    cata_assert( index < subtype_for_terrain.size() );
+    return subtype_for_terrain[index];
 }
 
 bool overmap_connection::has( const int_id<oter_t> &oter ) const
@@ -124,7 +109,17 @@ void overmap_connection::check() const
 
 void overmap_connection::finalize()
 {
-    cached_subtypes.resize( overmap_terrains::get_all().size() );
+    const size_t num_terrains = overmap_terrains::get_all().size();
+    subtype_for_terrain.clear();
+    subtype_for_terrain.reserve( num_terrains );
+    for( size_t i = 0; i < num_terrains; ++i ) {
+        const int_id<oter_t> ground( static_cast<int>( i ) );
+        const auto iter = std::find_if( subtypes.cbegin(),
+        subtypes.cend(), [&ground]( const subtype & elem ) {
+            return elem.allows_terrain( ground );
+        } );
+        subtype_for_terrain.push_back( iter != subtypes.cend() ? &*iter : nullptr );
+    }
 }
 
 void overmap_connections::load( const JsonObject &jo, const std::string &src )
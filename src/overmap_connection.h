@@ -60,16 +60,10 @@ class overmap_connection
         bool was_loaded = false;
 
     private:
-        struct cache {
-            const subtype *value = nullptr;
-            bool assigned = false;
-            explicit operator bool() const {
-                return assigned;
-            }
-        };
-
         std::list<subtype> subtypes;
-        mutable std::vector<cache> cached_subtypes;
+        // Result of pick_subtype_for by overmap terrain, built by finalize and only read
+        // afterwards because overmaps may be generated on another thread.
+        std::vector<const subtype *> subtype_for_terrain;
 };
 
 namespace overmap_connections
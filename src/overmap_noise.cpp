@@ -1,5 +1,7 @@
 #include <cmath>
 #include <algorithm>
+#include <future>
+#include <thread>
 
 #include "overmap_noise.h"
 #include "simplexnoise.h"
@@ -35,4 +37,32 @@ float om_noise_layer_lake::noise_at( const point_om_omt &local_omt_pos ) const
     return r;
 }
 
+om_noise_grid::om_noise_grid( const om_noise_layer &layer ) : layer( layer ),
+    values( OMAPX * OMAPY )
+{
+    // Each point is independent, so split the columns into one chunk per core.
+    const int chunks = std::max( 1, std::min<int>( std::thread::hardware_concurrency(), 8 ) );
+    const int chunk_size = ( OMAPX + chunks - 1 ) / chunks;
+    std::vector<std::future<void>> tasks;
+    for( int begin = chunk_size; begin < OMAPX; begin += chunk_size ) {
+        const int end = std::min( begin + chunk_size, OMAPX );
+        tasks.push_back( std::async( std::launch::async, [this, begin, end]() {
+            fill_columns( begin, end );
+        } ) );
+    }
+    fill_columns( 0, std::min( chunk_size, OMAPX ) );
+    for( std::future<void> &task : tasks ) {
+        task.get();
+    }
+}
+
+void om_noise_grid::fill_columns( int begin, int end )
+{
+    for( int x = begin; x < end; ++x ) {
+        for( int y = 0; y < OMAPY; ++y ) {
+            values[x * OMAPY + y] = layer.noise_at( point_om_omt( x, y ) );
+        }
+    }
+}
+
 } // namespace om_noise
@@ -2,6 +2,8 @@
 #ifndef CATA_SRC_OVERMAP_NOISE_H
 #define CATA_SRC_OVERMAP_NOISE_H
 
+#include <vector>
+
 #include "coordinates.h"
 #include "game_constants.h"
 
@@ -77,6 +79,34 @@ class om_noise_layer_lake : public om_noise_layer
         float noise_at( const point_om_omt &local_omt_pos ) const override;
 };
 
+/**
+ * A noise layer evaluated once for every overmap terrain of an overmap.
+ * Placement passes look at most points more than once (flood fills, several
+ * thresholds), and each evaluation is dozens of octaves of simplex noise, so
+ * they read from this grid instead.  The columns are computed in parallel.
+ * Points outside of the overmap are passed through to the layer, which must
+ * outlive the grid.
+ */
+class om_noise_grid
+{
+    public:
+        explicit om_noise_grid( const om_noise_layer &layer );
+
+        float noise_at( const point_om_omt &omt_local ) const {
+            if( omt_local.x() < 0 || omt_local.y() < 0 || omt_local.x() >= OMAPX ||
+                omt_local.y() >= OMAPY ) {
+                return layer.noise_at( omt_local );
+            }
+            return values[omt_local.x() * OMAPY + omt_local.y()];
+        }
+
+    private:
+        void fill_columns( int begin, int end );
+
+        const om_noise_layer &layer;
+        std::vector<float> values;
+};
+
 } // namespace om_noise
 
 #endif // CATA_SRC_OVERMAP_NOISE_H
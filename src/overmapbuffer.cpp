@@ -1,12 +1,15 @@
 #include "overmapbuffer.h"
 
 #include <algorithm>
+#include <chrono>
 #include <climits>
+#include <exception>
 #include <iterator>
 #include <list>
 #include <map>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 
 #include "basecamp.h"
 #include "calendar.h"
@@ -22,6 +25,7 @@
 #include "filesystem.h"
 #include "game.h"
 #include "game_constants.h"
+#include "generic_factory.h"
 #include "line.h"
 #include "map.h"
 #include "memory_fast.h"
@@ -29,11 +33,13 @@
 #include "monster.h"
 #include "npc.h"
 #include "optional.h"
+#include "options.h"
 #include "overmap.h"
 #include "overmap_connection.h"
 #include "overmap_types.h"
 #include "path_info.h"
 #include "point.h"
+#include "profiler.h"
 #include "rng.h"
 #include "simple_pathfinding.h"
 #include "string_formatter.h"
@@ -79,6 +85,7 @@ overmap &overmapbuffer::get( const point_abs_om &p )
         return *last_requested_overmap;
     }
 
+    wait_for_generation( p );
     const auto it = overmaps.find( p );
     if( it != overmaps.end() ) {
         return *( last_requested_overmap = it->second.get() );
@@ -87,6 +94,7 @@ overmap &overmapbuffer::get( const point_abs_om &p )
     // That constructor loads an existing overmap or creates a new one.
     overmap &new_om = *( overmaps[ p ] = std::make_unique<overmap>( p ) );
     new_om.populate();
+    new_om.finish_generation();
     // Note: fix_mongroups might load other overmaps, so overmaps.back() is not
     // necessarily the overmap at (x,y)
     fix_mongroups( new_om );
@@ -98,6 +106,7 @@ overmap &overmapbuffer::get( const point_abs_om &p )
 
 void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_special_batch &specials )
 {
+    wait_for_generation( p );
     if( last_requested_overmap != nullptr ) {
         auto om_iter = overmaps.find( p );
         if( om_iter != overmaps.end() && om_iter->second.get() == last_requested_overmap ) {
@@ -106,6 +115,119 @@ void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_specia
     }
     overmap &new_om = *( overmaps[ p ] = std::make_unique<overmap>( p ) );
     new_om.populate( specials );
+    new_om.finish_generation( specials );
+}
+
+void overmapbuffer::prefetch( const point_abs_om &p )
+{
+    // Nothing is generated in that mode, see overmap::open.
+    if( g->gametype() == special_game_type::DEFENSE || overmaps.count( p ) > 0 || ( generating_pos && *generating_pos == p ) ||
+        std::find( prefetch_queue.begin(), prefetch_queue.end(), p ) != prefetch_queue.end() ) {
+        return;
+    }
+    prefetch_queue.push_back( p );
+    process_prefetch();
+}
+
+void overmapbuffer::prefetch_near( const tripoint_abs_omt &p )
+{
+    point_abs_om om_pos;
+    point_om_omt local;
+    std::tie( om_pos, local ) = project_remain<coords::om>( p.xy() );
+    const auto near_side = []( int coord, int size, int dir ) {
+        return dir == 0 || ( dir < 0 ? coord < prefetch_margin : coord >= size - prefetch_margin );
+    };
+    for( int dx = -1; dx <= 1; ++dx ) {
+        for( int dy = -1; dy <= 1; ++dy ) {
+            if( ( dx != 0 || dy != 0 ) && near_side( local.x(), OMAPX, dx ) &&
+                near_side( local.y(), OMAPY, dy ) ) {
+                prefetch( om_pos + point( dx, dy ) );
+            }
+        }
+    }
+}
+
+void overmapbuffer::process_prefetch()
+{
+    if( generating_pos ) {
+        if( generating.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+            return;
+        }
+        finish_generation();
+    }
+    while( !prefetch_queue.empty() ) {
+        const point_abs_om p = prefetch_queue.front();
+        prefetch_queue.pop_front();
+        // Loading from disk is quick, leave that to whoever needs the overmap.
+        if( overmaps.count( p ) == 0 && !file_exist( terrain_filename( p ) ) ) {
+            start_generation( p );
+            return;
+        }
+    }
+}
+
+om_generation_inputs overmapbuffer::generation_inputs( const point_abs_om &p )
+{
+    om_generation_inputs inputs;
+    inputs.seed = g->get_seed();
+    inputs.city_size = get_option<int>( "CITY_SIZE" );
+    inputs.city_spacing = get_option<int>( "CITY_SPACING" );
+    inputs.wander_spawns = get_option<bool>( "WANDER_SPAWNS" );
+    inputs.disable_animal_clash = get_option<bool>( "DISABLE_ANIMAL_CLASH" );
+    for( const om_direction::type dir : om_direction::all ) {
+        if( const overmap *om = get_existing( p + om_direction::displace( dir ) ) ) {
+            inputs.neighbours[static_cast<int>( dir )] = om->edge_towards( om_direction::opposite( dir ) );
+        }
+    }
+    return inputs;
+}
+
+void overmapbuffer::start_generation( const point_abs_om &p )
+{
+    CATA_PROFILE_ZONE( "overmapbuffer::start_generation" );
+    std::unique_ptr<overmap> new_om = std::make_unique<overmap>( p );
+    overmap_special_batch specials = new_om->default_specials();
+    generating_pos = p;
+    generating = std::async( std::launch::async,
+    []( std::unique_ptr<overmap> om, const om_generation_inputs & inputs,
+    overmap_special_batch specials ) {
+        // The string ids in the game data are shared with the main thread.
+        restore_on_out_of_scope<bool> restore_cache( string_id_cache_enabled() );
+        string_id_cache_enabled() = false;
+        om->generate( inputs, specials );
+        // The thread may be kept around for other tasks.
+        pf::get_search_scratch().release();
+        return om;
+    }, std::move( new_om ), generation_inputs( p ), std::move( specials ) );
+}
+
+void overmapbuffer::finish_generation()
+{
+    const point_abs_om p = *generating_pos;
+    std::unique_ptr<overmap> new_om;
+    try {
+        new_om = generating.get();
+    } catch( const std::exception &err ) {
+        debugmsg( "overmap %s failed to generate: %s", p.to_string(), err.what() );
+    }
+    generating_pos.reset();
+    // Nothing may create the overmap while it is being generated, but be careful anyway.
+    if( !new_om || overmaps.count( p ) > 0 ) {
+        return;
+    }
+    overmap &om = *( overmaps[p] = std::move( new_om ) );
+    om.finish_generation();
+    fix_mongroups( om );
+    fix_npcs( om );
+}
+
+void overmapbuffer::wait_for_generation( const point_abs_om &p )
+{
+    if( generating_pos && *generating_pos == p ) {
+        CATA_PROFILE_ZONE( "overmapbuffer::wait_for_generation" );
+        generating.wait();
+        finish_generation();
+    }
 }
 
 void overmapbuffer::fix_mongroups( overmap &new_overmap )
@@ -195,6 +317,7 @@ void overmapbuffer::fix_npcs( overmap &new_overmap )
 
 void overmapbuffer::save()
 {
+    CATA_PROFILE_ZONE( "overmapbuffer::save" );
     for( auto &omp : overmaps ) {
         // Note: this may throw io errors from std::ofstream
         omp.second->save();
@@ -203,6 +326,12 @@ void overmapbuffer::save()
 
 void overmapbuffer::clear()
 {
+    if( generating_pos ) {
+        generating.wait();
+        generating = std::future<std::unique_ptr<overmap>>();
+        generating_pos.reset();
+    }
+    prefetch_queue.clear();
     overmaps.clear();
     known_non_existing.clear();
     last_requested_overmap = nullptr;
@@ -255,6 +384,7 @@ overmap *overmapbuffer::get_existing( const point_abs_om &p )
     if( last_requested_overmap && last_requested_overmap->pos() == p ) {
         return last_requested_overmap;
     }
+    wait_for_generation( p );
     const auto it = overmaps.find( p );
     if( it != overmaps.end() ) {
         return last_requested_overmap = it->second.get();
@@ -281,6 +411,9 @@ overmap *overmapbuffer::get_existing( const point_abs_om &p )
 
 bool overmapbuffer::has( const point_abs_om &p )
 {
+    if( generating_pos && *generating_pos == p ) {
+        return true;
+    }
     return get_existing( p ) != nullptr;
 }
 
@@ -728,18 +861,10 @@ std::vector<tripoint_abs_omt> overmapbuffer::get_npc_path(
     const auto get_ter_at = [&]( const point_rel_omt & p ) {
         return ter( base + p );
     };
-    const auto estimate =
-    [&]( const pf::node<point_rel_omt> &cur, const pf::node<point_rel_omt> * ) {
-        const tripoint_abs_omt convert_result = base + tripoint_rel_omt( cur.pos, 0 );
-        if( ptype.only_known_by_player && !seen( convert_result ) ) {
-            return pf::rejected;
-        }
-        int res = 0;
-        const oter_id oter = get_ter_at( cur.pos );
+    // The cost of entering a terrain, or pf::rejected.  The matching of terrain names is done
+    // once per terrain, not for each square searched.
+    const auto get_travel_cost = [&ptype]( const oter_id & oter ) {
         int travel_cost = static_cast<int>( oter->get_travel_cost() );
-        if( ptype.avoid_danger && is_marked_dangerous( convert_result ) ) {
-            return pf::rejected;
-        }
         if( ptype.only_road && ( !is_ot_match( "road", oter, ot_match_type::type ) &&
                                  !is_ot_match( "bridge", oter, ot_match_type::type ) &&
                                  !is_ot_match( "road_nesw_manhole", oter, ot_match_type::type ) ) ) {
@@ -774,10 +899,27 @@ std::vector<tripoint_abs_omt> overmapbuffer::get_npc_path(
                 return pf::rejected;
             }
         }
-        res += travel_cost;
-        res += manhattan_dist( finish, cur.pos );
-
-        return res;
+        return travel_cost;
+    };
+    std::unordered_map<oter_id, int> travel_costs;
+    const auto estimate =
+    [&]( const pf::node<point_rel_omt> &cur, const pf::node<point_rel_omt> * ) {
+        const tripoint_abs_omt convert_result = base + tripoint_rel_omt( cur.pos, 0 );
+        if( ptype.only_known_by_player && !seen( convert_result ) ) {
+            return pf::rejected;
+        }
+        if( ptype.avoid_danger && is_marked_dangerous( convert_result ) ) {
+            return pf::rejected;
+        }
+        const oter_id oter = get_ter_at( cur.pos );
+        auto travel_cost = travel_costs.find( oter );
+        if( travel_cost == travel_costs.end() ) {
+            travel_cost = travel_costs.emplace( oter, get_travel_cost( oter ) ).first;
+        }
+        if( travel_cost->second == pf::rejected ) {
+            return pf::rejected;
+        }
+        return travel_cost->second + manhattan_dist( finish, cur.pos );
     };
     pf::path<point_rel_omt> route = pf::find_path( start, finish, 2 * O, estimate );
     for( auto node : route.nodes ) {
@@ -817,28 +959,31 @@ bool overmapbuffer::reveal_route( const tripoint_abs_omt &source, const tripoint
         return false;
     }
 
+    // The cost of entering each terrain, looked up once per terrain
+    std::unordered_map<oter_id, int> travel_costs;
     const auto estimate =
     [&]( const pf::node<point_rel_omt> &cur, const pf::node<point_rel_omt> * ) {
-        int res = 0;
-
         const oter_id oter = get_ter_at( cur.pos );
-
-        if( !connection->has( oter ) ) {
-            if( road_only ) {
-                return pf::rejected;
-            }
-
-            if( is_river( oter ) ) {
-                return pf::rejected; // Can't walk on water
+        auto travel_cost = travel_costs.find( oter );
+        if( travel_cost == travel_costs.end() ) {
+            int res = 0;
+            if( !connection->has( oter ) ) {
+                if( road_only ) {
+                    res = pf::rejected;
+                } else if( is_river( oter ) ) {
+                    res = pf::rejected; // Can't walk on water
+                } else {
+                    // Allow going slightly off-road to overcome small obstacles (e.g. craters),
+                    // but heavily penalize that to make roads preferable
+                    res = 250;
+                }
             }
-            // Allow going slightly off-road to overcome small obstacles (e.g. craters),
-            // but heavily penalize that to make roads preferable
-            res += 250;
+            travel_cost = travel_costs.emplace( oter, res ).first;
         }
-
-        res += manhattan_dist( finish, cur.pos );
-
-        return res;
+        if( travel_cost->second == pf::rejected ) {
+            return pf::rejected;
+        }
+        return travel_cost->second + manhattan_dist( finish, cur.pos );
     };
 
     const auto path = pf::find_path( start, finish, 2 * O, estimate );
@@ -924,7 +1069,12 @@ bool overmapbuffer::is_findable_location( const tripoint_abs_omt &location,
     if( !type_matches ) {
         return false;
     }
+    return meets_find_conditions( location, params );
+}
 
+bool overmapbuffer::meets_find_conditions( const tripoint_abs_omt &location,
+        const omt_find_params &params )
+{
     if( params.must_see && !seen( location ) ) {
         return false;
     }
@@ -947,6 +1097,68 @@ bool overmapbuffer::is_findable_location( const tripoint_abs_omt &location,
     return true;
 }
 
+// The overmaps with squares within max_dist of origin, paired with the distance of their
+// nearest square to it, nearest first.
+static std::vector<std::pair<int, point_abs_om>> overmaps_in_range( const point_abs_omt &origin,
+        const int max_dist )
+{
+    const point_abs_om min_om = project_to<coords::om>( origin - point( max_dist, max_dist ) );
+    const point_abs_om max_om = project_to<coords::om>( origin + point( max_dist, max_dist ) );
+    std::vector<std::pair<int, point_abs_om>> result;
+    for( int y = min_om.y(); y <= max_om.y(); ++y ) {
+        for( int x = min_om.x(); x <= max_om.x(); ++x ) {
+            const point_abs_om om_pos( x, y );
+            const point_abs_omt corner = project_to<coords::omt>( om_pos );
+            const point far_corner = corner.raw() + point( OMAPX - 1, OMAPY - 1 );
+            const int dx = std::max( { 0, corner.x() - origin.x(), origin.x() - far_corner.x } );
+            const int dy = std::max( { 0, corner.y() - origin.y(), origin.y() - far_corner.y } );
+            result.emplace_back( std::max( dx, dy ), om_pos );
+        }
+    }
+    std::stable_sort( result.begin(), result.end(),
+    []( const std::pair<int, point_abs_om> &a, const std::pair<int, point_abs_om> &b ) {
+        return a.first < b.first;
+    } );
+    return result;
+}
+
+std::vector<std::pair<int, tripoint_abs_omt>> overmapbuffer::find_terrain_candidates(
+            const point_abs_om &om_pos, const tripoint_abs_omt &origin, const int min_dist,
+            const int max_dist, const int min_z, const int max_z, const omt_find_params &params,
+            std::unordered_map<oter_id, bool> &matches )
+{
+    std::vector<std::pair<int, tripoint_abs_omt>> result;
+    if( params.existing_only && !has( om_pos ) ) {
+        return result;
+    }
+    const overmap &om = get( om_pos );
+    for( int z = min_z; z <= max_z; ++z ) {
+        const om_terrain_index &index = om.terrain_index( z );
+        for( const om_terrain_index::run &r : index.runs ) {
+            auto match = matches.find( r.id );
+            if( match == matches.end() ) {
+                const bool is_match = std::any_of( params.types.begin(), params.types.end(),
+                [&r]( const std::pair<std::string, ot_match_type> &type ) {
+                    return is_ot_match( type.first, r.id, type.second );
+                } );
+                match = matches.emplace( r.id, is_match ).first;
+            }
+            if( !match->second ) {
+                continue;
+            }
+            for( int i = r.begin; i < r.end; ++i ) {
+                const tripoint_abs_omt loc = project_combine( om_pos,
+                                             tripoint_om_omt( index.cell_point( i ), z ) );
+                const int dist_xy = square_dist( origin.xy(), loc.xy() );
+                if( dist_xy >= min_dist && dist_xy <= max_dist ) {
+                    result.emplace_back( square_dist( origin, loc ), loc );
+                }
+            }
+        }
+    }
+    return result;
+}
+
 tripoint_abs_omt overmapbuffer::find_closest(
     const tripoint_abs_omt &origin, const std::string &type, int const radius, bool must_be_seen,
     ot_match_type match_type, bool existing_overmaps_only,
@@ -983,28 +1195,35 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
     const int min_dist = params.min_distance;
     const int max_dist = params.search_range ? params.search_range : OMAPX * 5;
 
+    // The squares with a matching terrain are looked up in the terrain index of each overmap,
+    // going through the overmaps nearest first until the rest are further than what was found.
     std::vector<tripoint_abs_omt> result;
     cata::optional<int> found_dist;
+    std::unordered_map<oter_id, bool> matches;
 
-    for( const point_abs_omt &loc_xy : closest_points_first( origin.xy(), min_dist, max_dist ) ) {
-        const int dist_xy = square_dist( origin.xy(), loc_xy );
-
-        if( found_dist && *found_dist < dist_xy ) {
+    for( const std::pair<int, point_abs_om> &om : overmaps_in_range( origin.xy(), max_dist ) ) {
+        if( found_dist && *found_dist < om.first ) {
             break;
         }
-
-        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
-            const tripoint_abs_omt loc( loc_xy, z );
-            const int dist = square_dist( origin, loc );
-
-            if( found_dist && *found_dist < dist ) {
+        std::vector<std::pair<int, tripoint_abs_omt>> candidates = find_terrain_candidates(
+                    om.second, origin, min_dist, max_dist, -OVERMAP_DEPTH, OVERMAP_HEIGHT, params,
+                    matches );
+        std::stable_sort( candidates.begin(), candidates.end(),
+        []( const std::pair<int, tripoint_abs_omt> &a, const std::pair<int, tripoint_abs_omt> &b ) {
+            return a.first < b.first;
+        } );
+        for( const std::pair<int, tripoint_abs_omt> &candidate : candidates ) {
+            if( found_dist && *found_dist < candidate.first ) {
+                break;
+            }
+            if( !meets_find_conditions( candidate.second, params ) ) {
                 continue;
             }
-
-            if( is_findable_location( loc, params ) ) {
-                found_dist = dist;
-                result.push_back( loc );
+            if( !found_dist || candidate.first < *found_dist ) {
+                found_dist = candidate.first;
+                result.clear();
             }
+            result.push_back( candidate.second );
         }
     }
 
@@ -1014,14 +1233,27 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
 std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &origin,
         const omt_find_params &params )
 {
-    std::vector<tripoint_abs_omt> result;
     // dist == 0 means search a whole overmap diameter.
     const int min_dist = params.min_distance;
     const int max_dist = params.search_range ? params.search_range : OMAPX;
 
-    for( const tripoint_abs_omt &loc : closest_points_first( origin, min_dist, max_dist ) ) {
-        if( is_findable_location( loc, params ) ) {
-            result.push_back( loc );
+    std::vector<std::pair<int, tripoint_abs_omt>> candidates;
+    std::unordered_map<oter_id, bool> matches;
+    for( const std::pair<int, point_abs_om> &om : overmaps_in_range( origin.xy(), max_dist ) ) {
+        std::vector<std::pair<int, tripoint_abs_omt>> om_candidates = find_terrain_candidates(
+                    om.second, origin, min_dist, max_dist, origin.z(), origin.z(), params, matches );
+        candidates.insert( candidates.end(), om_candidates.begin(), om_candidates.end() );
+    }
+    // Nearest first, as before the index
+    std::stable_sort( candidates.begin(), candidates.end(),
+    []( const std::pair<int, tripoint_abs_omt> &a, const std::pair<int, tripoint_abs_omt> &b ) {
+        return a.first < b.first;
+    } );
+
+    std::vector<tripoint_abs_omt> result;
+    for( const std::pair<int, tripoint_abs_omt> &candidate : candidates ) {
+        if( meets_find_conditions( candidate.second, params ) ) {
+            result.push_back( candidate.second );
         }
     }
 
@@ -3,7 +3,9 @@
 #define CATA_SRC_OVERMAPBUFFER_H
 
 #include <array>
+#include <deque>
 #include <functional>
+#include <future>
 #include <iosfwd>
 #include <memory>
 #include <new>
@@ -29,6 +31,7 @@ class overmap;
 class overmap_special_batch;
 class vehicle;
 struct mongroup;
+struct om_generation_inputs;
 struct om_vehicle;
 struct radio_tower;
 struct regional_settings;
@@ -139,6 +142,30 @@ class overmapbuffer
         void clear();
         void create_custom_overmap( const point_abs_om &, overmap_special_batch &specials );
 
+        /**
+         * Queues the overmap to be generated on a background thread, unless it
+         * already exists in memory or on disk.  Overmaps are generated one at a time
+         * in the order they were queued.  Anything that needs a queued overmap before
+         * it is done simply waits for it (or generates it itself if it was not started yet).
+         */
+        void prefetch( const point_abs_om &p );
+        /**
+         * Prefetches the overmaps next to the one containing @p p if @p p is
+         * within @ref prefetch_margin overmap terrains of their shared edge.
+         */
+        void prefetch_near( const tripoint_abs_omt &p );
+        /**
+         * Takes over the overmap generated in the background once it is done and starts
+         * generating the next queued one.  Never blocks, called once per turn.
+         */
+        void process_prefetch();
+        static constexpr int prefetch_margin = OMAPX / 4;
+        /**
+         * What generating the overmap at @p p reads from outside of it: options, the world
+         * seed and the edges of its existing neighbours, see overmap::generate.
+         */
+        om_generation_inputs generation_inputs( const point_abs_om &p );
+
         /**
          * Uses global overmap terrain coordinates, creates the
          * overmap if needed.
@@ -350,7 +377,8 @@ class overmapbuffer
         /**
          * Pass global overmap coordinates (same as @ref get).
          * @returns true if the buffer has a overmap with
-         * the given coordinates.
+         * the given coordinates.  An overmap that is being generated
+         * in the background counts, without waiting for it.
          */
         bool has( const point_abs_om &p );
         /**
@@ -358,6 +386,8 @@ class overmapbuffer
          * and may return NULL if the requested overmap does not
          * exist.
          * (x,y) are global overmap coordinates (same as @ref get).
+         * If the overmap is being generated in the background, this
+         * blocks until it is done, like @ref get.
          */
         overmap *get_existing( const point_abs_om &p );
         /**
@@ -482,6 +512,19 @@ class overmapbuffer
          * see omt_find_params for definitions of the terms
          */
         bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params );
+        /** Whether @p location meets the conditions of @p params other than its terrain. */
+        bool meets_find_conditions( const tripoint_abs_omt &location, const omt_find_params &params );
+        /**
+         * The squares of overmap @p om_pos on z-levels @p min_z to @p max_z whose terrain is one
+         * of params.types and which are @p min_dist to @p max_dist squares (horizontally) from
+         * @p origin, paired with their distance to @p origin.  Nothing if the overmap does not
+         * exist and params.existing_only is set.
+         * @param matches Caches which terrains are one of params.types.
+         */
+        std::vector<std::pair<int, tripoint_abs_omt>> find_terrain_candidates(
+                    const point_abs_om &om_pos, const tripoint_abs_omt &origin, int min_dist,
+                    int max_dist, int min_z, int max_z, const omt_find_params &params,
+                    std::unordered_map<oter_id, bool> &matches );
 
         std::unordered_map< point_abs_om, std::unique_ptr< overmap > > overmaps;
         /**
@@ -525,6 +568,17 @@ class overmapbuffer
         bool check_overmap_special_type_existing( const overmap_special_id &id,
                 const tripoint_abs_omt &loc );
     private:
+        void start_generation( const point_abs_om &p );
+        /** Waits for the background generation and adopts its result. */
+        void finish_generation();
+        /** Finishes the background generation if it is generating @p p. */
+        void wait_for_generation( const point_abs_om &p );
+
+        std::deque<point_abs_om> prefetch_queue;
+        // Overmap currently generated in the background, if any
+        cata::optional<point_abs_om> generating_pos;
+        std::future<std::unique_ptr<overmap>> generating;
+
         /**
          * Go thorough the monster groups of the overmap and move out-of-bounds
          * groups to the correct overmap (if it exists), also removes empty groups.
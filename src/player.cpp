@@ -1143,7 +1143,19 @@ void player::on_worn_item_transform( const item &old_it, const item &new_it )
 
 void player::process_items()
 {
-    if( weapon.needs_processing() && weapon.process( this, pos() ) ) {
+    // Processing can switch an item off or turn it into another one, either of
+    // which may change the enchantments it provides
+    const auto process_carried = [this]( item & it ) {
+        const itype_id type_before = it.typeId();
+        const bool active_before = it.active;
+        const bool destroyed = it.process( this, pos() );
+        if( !destroyed && ( it.typeId() != type_before || it.active != active_before ) ) {
+            invalidate_enchantment_cache();
+        }
+        return destroyed;
+    };
+
+    if( weapon.needs_processing() && process_carried( weapon ) ) {
         remove_weapon();
     }
 
@@ -1153,7 +1165,7 @@ void player::process_items()
             continue;
         }
         if( it->needs_processing() ) {
-            if( it->process( this, pos() ) ) {
+            if( process_carried( *it ) ) {
                 removed_items.push_back( it );
             }
         }
@@ -1959,6 +1971,7 @@ bool player::takeoff( item &it, std::list<item> *res )
 
     item takeoff_copy( it );
     worn.erase( iter );
+    invalidate_enchantment_cache();
     takeoff_copy.on_takeoff( *this );
     if( res == nullptr ) {
         i_add( takeoff_copy, true, &it );
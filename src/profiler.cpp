@@ -0,0 +1,277 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+#include "cata_utility.h"
+#include "json.h"
+#include "string_formatter.h"
+
+namespace profiler
+{
+
+namespace
+{
+
+struct thread_ring {
+    explicit thread_ring( int id ) : tid( id ), samples( ring_buffer_size ) {}
+
+    const int tid;
+    // Taken by the owning thread for each sample, so it only waits while another thread reads
+    // or clears the ring.
+    mutable std::mutex mutex;
+    std::vector<zone_sample> samples;
+    // total number of samples ever written, the write position is head % size
+    uint64_t head = 0;
+
+    void push( const zone_sample &s ) {
+        std::lock_guard<std::mutex> lock( mutex );
+        samples[head % samples.size()] = s;
+        ++head;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock( mutex );
+        head = 0;
+    }
+
+    template<typename F>
+    void for_each( F &&f ) const {
+        std::lock_guard<std::mutex> lock( mutex );
+        const uint64_t n = std::min<uint64_t>( head, samples.size() );
+        for( uint64_t i = head - n; i < head; ++i ) {
+            f( samples[i % samples.size()] );
+        }
+    }
+};
+
+struct registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<thread_ring>> rings;
+    // rings of threads that have exited, reused before allocating new ones
+    std::vector<thread_ring *> free_rings;
+    // start of the last few turns, written by the main thread only
+    std::array<int64_t, 256> turn_starts;
+    uint64_t turn_count = 0;
+};
+
+registry &get_registry()
+{
+    static registry r;
+    return r;
+}
+
+std::atomic<bool> profiler_enabled{ false };
+
+// Hands the ring of a thread back to the registry when the thread exits.
+struct ring_owner {
+    thread_ring *ring = nullptr;
+
+    ~ring_owner() {
+        if( ring != nullptr ) {
+            registry &r = get_registry();
+            std::lock_guard<std::mutex> lock( r.mutex );
+            r.free_rings.push_back( ring );
+        }
+    }
+};
+
+thread_local ring_owner local_ring;
+thread_local int local_depth = 0;
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+thread_ring &get_local_ring()
+{
+    if( local_ring.ring == nullptr ) {
+        registry &r = get_registry();
+        std::lock_guard<std::mutex> lock( r.mutex );
+        if( !r.free_rings.empty() ) {
+            // Samples of the previous owner stay visible until overwritten.
+            local_ring.ring = r.free_rings.back();
+            r.free_rings.pop_back();
+        } else {
+            r.rings.emplace_back( std::make_unique<thread_ring>( static_cast<int>( r.rings.size() ) ) );
+            local_ring.ring = r.rings.back().get();
+        }
+    }
+    return *local_ring.ring;
+}
+
+} // namespace
+
+bool compiled_in()
+{
+#if defined(CATA_PROFILER)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool enabled()
+{
+    return profiler_enabled.load( std::memory_order_relaxed );
+}
+
+void set_enabled( bool enable )
+{
+    profiler_enabled.store( enable, std::memory_order_relaxed );
+}
+
+void clear()
+{
+    registry &r = get_registry();
+    std::lock_guard<std::mutex> lock( r.mutex );
+    for( std::unique_ptr<thread_ring> &ring : r.rings ) {
+        ring->clear();
+    }
+    r.turn_count = 0;
+}
+
+int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - epoch ).count();
+}
+
+void mark_turn()
+{
+    if( !enabled() ) {
+        return;
+    }
+    registry &r = get_registry();
+    r.turn_starts[r.turn_count % r.turn_starts.size()] = now_ns();
+    ++r.turn_count;
+}
+
+void record( const char *name, int64_t start_ns, int64_t end_ns )
+{
+    zone_sample s;
+    s.name = name;
+    s.start_ns = start_ns;
+    s.end_ns = end_ns;
+    s.depth = local_depth;
+    get_local_ring().push( s );
+}
+
+std::vector<zone_sample> thread_samples()
+{
+    std::vector<zone_sample> result;
+    get_local_ring().for_each( [&]( const zone_sample & s ) {
+        result.push_back( s );
+    } );
+    return result;
+}
+
+std::vector<zone_stats> summarize( int turns )
+{
+    registry &r = get_registry();
+    std::lock_guard<std::mutex> lock( r.mutex );
+
+    int64_t window_start = 0;
+    if( turns > 0 && r.turn_count > 0 ) {
+        const uint64_t kept = std::min<uint64_t>( r.turn_count, r.turn_starts.size() );
+        const uint64_t back = std::min<uint64_t>( turns, kept );
+        window_start = r.turn_starts[( r.turn_count - back ) % r.turn_starts.size()];
+    }
+
+    // Zone names are literals, so identical names from different translation
+    // units may have distinct addresses; key by content.
+    std::unordered_map<std::string, zone_stats> by_name;
+    for( const std::unique_ptr<thread_ring> &ring : r.rings ) {
+        ring->for_each( [&]( const zone_sample & s ) {
+            if( s.start_ns < window_start ) {
+                return;
+            }
+            zone_stats &st = by_name[s.name];
+            const int64_t duration = s.end_ns - s.start_ns;
+            ++st.calls;
+            st.total_ns += duration;
+            st.max_ns = std::max( st.max_ns, duration );
+        } );
+    }
+
+    std::vector<zone_stats> result;
+    result.reserve( by_name.size() );
+    for( std::pair<const std::string, zone_stats> &p : by_name ) {
+        p.second.name = p.first;
+        result.push_back( p.second );
+    }
+    std::sort( result.begin(), result.end(), []( const zone_stats & lhs, const zone_stats & rhs ) {
+        return lhs.total_ns > rhs.total_ns;
+    } );
+    return result;
+}
+
+std::string summary_text( int turns )
+{
+    const std::vector<zone_stats> stats = summarize( turns );
+    const int turns_kept = std::max<int>( 1, std::min<uint64_t>( turns,
+                                          get_registry().turn_count ) );
+    std::string result = string_format( "%-40s %8s %10s %10s %10s\n", "zone", "calls",
+                                        "total ms", "ms/turn", "max ms" );
+    for( const zone_stats &s : stats ) {
+        result += string_format( "%-40s %8d %10.3f %10.3f %10.3f\n", s.name, s.calls,
+                                 s.total_ns / 1e6, s.total_ns / 1e6 / turns_kept, s.max_ns / 1e6 );
+    }
+    return result;
+}
+
+bool write_chrome_trace( const std::string &path )
+{
+    return write_to_file( path, [&]( std::ostream & fout ) {
+        registry &r = get_registry();
+        std::lock_guard<std::mutex> lock( r.mutex );
+        JsonOut jsout( fout );
+        jsout.start_object();
+        jsout.member( "displayTimeUnit", "ns" );
+        jsout.member( "traceEvents" );
+        jsout.start_array();
+        for( const std::unique_ptr<thread_ring> &ring : r.rings ) {
+            ring->for_each( [&]( const zone_sample & s ) {
+                jsout.start_object();
+                jsout.member( "name", s.name );
+                jsout.member( "ph", "X" );
+                // trace-event timestamps are in (fractional) microseconds
+                jsout.member( "ts", s.start_ns / 1000.0 );
+                jsout.member( "dur", ( s.end_ns - s.start_ns ) / 1000.0 );
+                jsout.member( "pid", 0 );
+                jsout.member( "tid", ring->tid );
+                jsout.end_object();
+            } );
+        }
+        jsout.end_array();
+        jsout.end_object();
+    }, "profiler trace" );
+}
+
+zone::zone( const char *name ) : name( name ), start_ns( -1 )
+{
+    if( enabled() ) {
+        start_ns = now_ns();
+        ++local_depth;
+    }
+}
+
+zone::~zone()
+{
+    end();
+}
+
+void zone::end()
+{
+    if( start_ns >= 0 ) {
+        --local_depth;
+        record( name, start_ns, now_ns() );
+        start_ns = -1;
+    }
+}
+
+} // namespace profiler
@@ -0,0 +1,126 @@
+#pragma once
+#ifndef CATA_SRC_PROFILER_H
+#define CATA_SRC_PROFILER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Low overhead scoped-zone profiler.
+ *
+ * Zones are marked with CATA_PROFILE_ZONE( "name" ), which records the time
+ * spent until the end of the enclosing scope.  Each thread writes completed
+ * zones into its own fixed size ring buffer, so recording never allocates once
+ * the buffer for a thread exists.  The lock of a buffer is only contended
+ * while the zones are read or cleared.  Only the most recent
+ * ring_buffer_size zones per thread are kept.  The buffer of a thread that
+ * exits is handed to the next new thread instead of being freed, so worker
+ * threads do not grow memory use without bound.
+ *
+ * The recorded data can be exported as a Chrome trace-event JSON file (load it
+ * in chrome://tracing or https://ui.perfetto.dev) or summarized over the last
+ * few turns.
+ *
+ * Zone markers are compiled out entirely unless the build defines
+ * CATA_PROFILER (cmake -DPROFILER=ON, or make PROFILER=1).  The recording
+ * machinery itself is always built so that tests and the debug menu do not
+ * need to care, but without markers there is nothing to record.
+ *
+ * Zone names must be string literals (or otherwise outlive the profiler); only
+ * the pointer is stored.
+ */
+namespace profiler
+{
+
+constexpr int ring_buffer_size = 1 << 16;
+
+struct zone_sample {
+    const char *name = nullptr;
+    // nanoseconds since the profiler epoch
+    int64_t start_ns = 0;
+    int64_t end_ns = 0;
+    // nesting depth of the zone on its thread, 0 for outermost zones
+    int depth = 0;
+};
+
+struct zone_stats {
+    std::string name;
+    int calls = 0;
+    int64_t total_ns = 0;
+    int64_t max_ns = 0;
+};
+
+/** Whether zone markers were compiled into this build. */
+bool compiled_in();
+
+/** Recording is off by default; markers cost one branch while disabled. */
+bool enabled();
+void set_enabled( bool enable );
+
+/** Drops everything recorded so far on all threads. */
+void clear();
+
+/** Nanoseconds since the profiler epoch. */
+int64_t now_ns();
+
+/** Marks the start of a game turn, used to window the summary. */
+void mark_turn();
+
+/**
+ * Records a completed zone for the calling thread.  Normally only used by
+ * @ref zone, exposed for instrumentation that cannot use a scope.
+ */
+void record( const char *name, int64_t start_ns, int64_t end_ns );
+
+/** Copy of all samples recorded on the calling thread, oldest first. */
+std::vector<zone_sample> thread_samples();
+
+/**
+ * Per zone statistics for zones that started within the last @p turns turns,
+ * sorted by total time, most expensive first.
+ */
+std::vector<zone_stats> summarize( int turns );
+/** Human readable table of @ref summarize, for the debug menu. */
+std::string summary_text( int turns );
+
+/** Writes everything recorded so far as Chrome trace-event JSON. */
+bool write_chrome_trace( const std::string &path );
+
+class zone
+{
+    public:
+        explicit zone( const char *name );
+        ~zone();
+
+        /** Records the zone now instead of at the end of the scope. */
+        void end();
+
+        zone( const zone & ) = delete;
+        zone &operator=( const zone & ) = delete;
+    private:
+        const char *name;
+        // negative if the profiler was disabled when the zone was entered
+        int64_t start_ns;
+};
+
+} // namespace profiler
+
+#if defined(CATA_PROFILER)
+#define CATA_PROFILE_CONCAT2( a, b ) a##b
+#define CATA_PROFILE_CONCAT( a, b ) CATA_PROFILE_CONCAT2( a, b )
+#define CATA_PROFILE_ZONE( name ) \
+    profiler::zone CATA_PROFILE_CONCAT( profile_zone_, __LINE__ )( name )
+// A zone that can be closed early with CATA_PROFILE_ZONE_END, e.g. before
+// blocking on player input.
+#define CATA_PROFILE_ZONE_NAMED( var, name ) profiler::zone var( name )
+#define CATA_PROFILE_ZONE_END( var ) var.end()
+#define CATA_PROFILE_TURN() profiler::mark_turn()
+#else
+#define CATA_PROFILE_ZONE( name ) static_cast<void>( 0 )
+#define CATA_PROFILE_ZONE_NAMED( var, name ) static_cast<void>( 0 )
+#define CATA_PROFILE_ZONE_END( var ) static_cast<void>( 0 )
+#define CATA_PROFILE_TURN() static_cast<void>( 0 )
+#endif
+
+#endif // CATA_SRC_PROFILER_H
@@ -11,13 +11,13 @@
 unsigned int rng_bits()
 {
     // Whole uint range.
-    static std::uniform_int_distribution<unsigned int> rng_uint_dist;
+    static thread_local std::uniform_int_distribution<unsigned int> rng_uint_dist;
     return rng_uint_dist( rng_get_engine() );
 }
 
 int rng( int lo, int hi )
 {
-    static std::uniform_int_distribution<int> rng_int_dist;
+    static thread_local std::uniform_int_distribution<int> rng_int_dist;
     if( lo > hi ) {
         std::swap( lo, hi );
     }
@@ -26,7 +26,7 @@ int rng( int lo, int hi )
 
 double rng_float( double lo, double hi )
 {
-    static std::uniform_real_distribution<double> rng_real_dist;
+    static thread_local std::uniform_real_distribution<double> rng_real_dist;
     if( lo > hi ) {
         std::swap( lo, hi );
     }
@@ -38,15 +38,23 @@ units::angle random_direction()
     return rng_float( 0_pi_radians, 2_pi_radians );
 }
 
+// The normal distribution keeps the second of the values it generates in pairs, it is part of
+// the state rng_seed_scope saves and restores.
+static std::normal_distribution<double> &rng_normal_dist()
+{
+    static thread_local std::normal_distribution<double> dist;
+    return dist;
+}
+
 double normal_roll( double mean, double stddev )
 {
-    static std::normal_distribution<double> rng_normal_dist;
-    return rng_normal_dist( rng_get_engine(), std::normal_distribution<>::param_type( mean, stddev ) );
+    return rng_normal_dist()( rng_get_engine(),
+                              std::normal_distribution<>::param_type( mean, stddev ) );
 }
 
 double exponential_roll( double lambda )
 {
-    static std::exponential_distribution<double> rng_exponential_dist;
+    static thread_local std::exponential_distribution<double> rng_exponential_dist;
     return rng_exponential_dist( rng_get_engine(),
                                  std::exponential_distribution<>::param_type( lambda ) );
 }
@@ -129,8 +137,10 @@ double rng_normal( double lo, double hi )
 
 cata_default_random_engine &rng_get_engine()
 {
+    // Every thread gets its own engine, so background work (e.g. overmap generation)
+    // neither races with nor disturbs the main thread's sequence.
     // NOLINTNEXTLINE(cata-determinism)
-    static cata_default_random_engine eng(
+    static thread_local cata_default_random_engine eng(
         std::chrono::high_resolution_clock::now().time_since_epoch().count() );
     return eng;
 }
@@ -141,3 +151,16 @@ void rng_set_engine_seed( unsigned int seed )
         rng_get_engine().seed( seed );
     }
 }
+
+rng_seed_scope::rng_seed_scope( unsigned int seed ) : saved( rng_get_engine() ),
+    saved_normal( rng_normal_dist() )
+{
+    rng_get_engine().seed( seed );
+    rng_normal_dist().reset();
+}
+
+rng_seed_scope::~rng_seed_scope()
+{
+    rng_get_engine() = saved;
+    rng_normal_dist() = saved_normal;
+}
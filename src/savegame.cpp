@@ -2,6 +2,7 @@
 
 #include <clocale>
 #include <algorithm>
+#include <array>
 #include <map>
 #include <sstream>
 #include <string>
@@ -32,6 +33,7 @@
 #include "options.h"
 #include "overmap.h"
 #include "overmap_types.h"
+#include "profiler.h"
 #include "regional_settings.h"
 #include "scent_map.h"
 #include "stats_tracker.h"
@@ -422,49 +424,89 @@ void overmap::load_legacy_monstergroups( JsonIn &jsin )
     }
 }
 
+namespace
+{
+// A terrain id read from an overmap save
+struct saved_terrain {
+    std::string id;
+    bool obsolete = false;
+    oter_id otid = oter_id( 0 );
+};
+} // namespace
+
 // throws std::exception
 void overmap::unserialize( std::istream &fin )
 {
+    CATA_PROFILE_ZONE( "overmap::unserialize" );
     chkversion( fin );
     JsonIn jsin( fin );
+    std::vector<saved_terrain> terrain_table;
+    const auto resolve_saved_terrain = []( const std::string & id ) {
+        saved_terrain result;
+        result.id = id;
+        if( obsolete_terrain( id ) ) {
+            result.obsolete = true;
+        } else if( oter_str_id( id ).is_valid() ) {
+            result.otid = oter_id( id );
+        } else {
+            debugmsg( "Loaded bad ter!  ter %s", id.c_str() );
+        }
+        return result;
+    };
     jsin.start_object();
     while( !jsin.end_object() ) {
         const std::string name = jsin.get_member_name();
-        if( name == "layers" ) {
+        if( name == "terrain_ids" ) {
+            // The ids the runs of the layers below refer to by index
+            std::vector<std::string> ids;
+            jsin.read( ids );
+            terrain_table.clear();
+            terrain_table.reserve( ids.size() );
+            for( const std::string &id : ids ) {
+                terrain_table.push_back( resolve_saved_terrain( id ) );
+            }
+        } else if( name == "layers" ) {
             std::unordered_map<tripoint_om_omt, std::string> needs_conversion;
             jsin.start_array();
             for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
                 jsin.start_array();
                 int count = 0;
-                std::string tmp_ter;
-                oter_id tmp_otid( 0 );
+                saved_terrain run;
                 for( int j = 0; j < OMAPY; j++ ) {
                     for( int i = 0; i < OMAPX; i++ ) {
                         if( count == 0 ) {
                             jsin.start_array();
-                            jsin.read( tmp_ter );
+                            if( jsin.test_int() ) {
+                                const int index = jsin.get_int();
+                                if( index >= 0 && static_cast<size_t>( index ) < terrain_table.size() ) {
+                                    run = terrain_table[index];
+                                } else {
+                                    debugmsg( "Loaded bad terrain index %d", index );
+                                    run = saved_terrain();
+                                }
+                            } else {
+                                // Older saves name the terrain of each run
+                                run = resolve_saved_terrain( jsin.get_string() );
+                            }
                             jsin.read( count );
                             jsin.end_array();
-                            if( obsolete_terrain( tmp_ter ) ) {
+                            if( run.obsolete ) {
                                 for( int p = i; p < i + count; p++ ) {
                                     needs_conversion.emplace(
-                                        tripoint_om_omt( p, j, z - OVERMAP_DEPTH ), tmp_ter );
+                                        tripoint_om_omt( p, j, z - OVERMAP_DEPTH ), run.id );
                                 }
-                                tmp_otid = oter_id( 0 );
-                            } else if( oter_str_id( tmp_ter ).is_valid() ) {
-                                tmp_otid = oter_id( tmp_ter );
-                            } else {
-                                debugmsg( "Loaded bad ter!  ter %s", tmp_ter.c_str() );
-                                tmp_otid = oter_id( 0 );
                             }
                         }
                         count--;
-                        layer[z].terrain[i][j] = tmp_otid;
+                        layer[z].terrain[i][j] = run.otid;
                     }
                 }
                 jsin.end_array();
             }
             jsin.end_array();
+            for( om_terrain_index &index : terrain_indices ) {
+                index.valid = false;
+            }
             convert_terrain( needs_conversion );
         } else if( name == "region_id" ) {
             std::string new_region_id;
@@ -893,34 +935,54 @@ void overmap::serialize( std::ostream &fout ) const
     JsonOut json( fout, false );
     json.start_object();
 
-    json.member( "layers" );
-    json.start_array();
+    std::array<std::vector<std::pair<oter_id, int>>, OVERMAP_LAYERS> runs;
     for( int z = 0; z < OVERMAP_LAYERS; ++z ) {
         const auto &layer_terrain = layer[z].terrain;
-        int count = 0;
-        oter_id last_tertype( -1 );
-        json.start_array();
         for( int j = 0; j < OMAPY; j++ ) {
             // NOLINTNEXTLINE(modernize-loop-convert)
             for( int i = 0; i < OMAPX; i++ ) {
-                oter_id t = layer_terrain[i][j];
-                if( t != last_tertype ) {
-                    if( count ) {
-                        json.write( count );
-                        json.end_array();
-                    }
-                    last_tertype = t;
-                    json.start_array();
-                    json.write( t.id() );
-                    count = 1;
+                const oter_id t = layer_terrain[i][j];
+                if( runs[z].empty() || runs[z].back().first != t ) {
+                    runs[z].emplace_back( t, 1 );
                 } else {
-                    count++;
+                    runs[z].back().second++;
                 }
             }
         }
-        json.write( count );
-        // End the last entry for a z-level.
-        json.end_array();
+    }
+
+    // Optionally, each run of the layers refers to its terrain by index in a table, so that
+    // loading only looks each id up once.  Builds from before that table, and tools reading the
+    // terrain of the runs, can't read such saves.
+    const bool terrain_table = get_option<bool>( "OVERMAP_TERRAIN_TABLE" );
+    std::unordered_map<oter_id, int> terrain_index;
+    if( terrain_table ) {
+        std::vector<std::string> terrain_ids;
+        for( const std::vector<std::pair<oter_id, int>> &layer_runs : runs ) {
+            for( const std::pair<oter_id, int> &run : layer_runs ) {
+                if( terrain_index.emplace( run.first, static_cast<int>( terrain_ids.size() ) ).second ) {
+                    terrain_ids.push_back( run.first.id().str() );
+                }
+            }
+        }
+        json.member( "terrain_ids", terrain_ids );
+        fout << std::endl;
+    }
+
+    json.member( "layers" );
+    json.start_array();
+    for( const std::vector<std::pair<oter_id, int>> &layer_runs : runs ) {
+        json.start_array();
+        for( const std::pair<oter_id, int> &run : layer_runs ) {
+            json.start_array();
+            if( terrain_table ) {
+                json.write( terrain_index[run.first] );
+            } else {
+                json.write( run.first.id() );
+            }
+            json.write( run.second );
+            json.end_array();
+        }
         // End the z-level
         json.end_array();
         // Insert a newline occasionally so the file isn't totally unreadable.
@@ -660,6 +660,7 @@ void Character::load( const JsonObject &data )
         if( mid.is_valid() ) {
             on_mutation_gain( mid );
             cached_mutations.push_back( &mid.obj() );
+            add_to_flag_index( flag_index, mid.obj(), 1 );
             ++it;
             // Remove after 0.F
         } else if( mid == trait_id( "PROF_HELI_PILOT" ) ) {
@@ -673,6 +674,7 @@ void Character::load( const JsonObject &data )
     recalculate_size();
 
     data.read( "my_bionics", *my_bionics );
+    rebuild_flag_index();
 
     for( auto &w : worn ) {
         w.on_takeoff( *this );
@@ -2428,6 +2430,7 @@ void item::io( Archive &archive )
     archive.io( "techniques", techniques, io::empty_default_tag() );
     archive.io( "faults", faults, io::empty_default_tag() );
     archive.io( "item_tags", item_tags, io::empty_default_tag() );
+    item_tag_bits.assign( item_tags );
     archive.io( "components", components, io::empty_default_tag() );
     archive.io( "specific_energy", specific_energy, -10 );
     archive.io( "temperature", temperature, 0 );
@@ -2520,13 +2523,9 @@ void item::io( Archive &archive )
     // Books without any chapters don't need to store a remaining-chapters
     // counter, it will always be 0 and it prevents proper stacking.
     if( get_chapters() == 0 ) {
-        for( auto it = item_vars.begin(); it != item_vars.end(); ) {
-            if( it->first.compare( 0, 19, "remaining-chapters-" ) == 0 ) {
-                item_vars.erase( it++ );
-            } else {
-                ++it;
-            }
-        }
+        item_vars.erase_if( []( const std::string & name ) {
+            return name.compare( 0, 19, "remaining-chapters-" ) == 0;
+        } );
     }
 
     // Remove stored translated gerund in favor of storing the inscription tool type
@@ -3407,97 +3406,6 @@ void player_morale::load( const JsonObject &jsin )
     jsin.read( "morale", points );
 }
 
-void map_memory::store( JsonOut &jsout ) const
-{
-    jsout.start_array();
-    jsout.start_array();
-    for( const auto &elem : tile_cache.list() ) {
-        jsout.start_array();
-        jsout.write( elem.first.x );
-        jsout.write( elem.first.y );
-        jsout.write( elem.first.z );
-        jsout.write( elem.second.tile );
-        jsout.write( elem.second.subtile );
-        jsout.write( elem.second.rotation );
-        jsout.end_array();
-    }
-    jsout.end_array();
-
-    jsout.start_array();
-    for( const auto &elem : symbol_cache.list() ) {
-        jsout.start_array();
-        jsout.write( elem.first.x );
-        jsout.write( elem.first.y );
-        jsout.write( elem.first.z );
-        jsout.write( elem.second );
-        jsout.end_array();
-    }
-    jsout.end_array();
-    jsout.end_array();
-}
-
-void map_memory::load( JsonIn &jsin )
-{
-    // Legacy loading of object version.
-    if( jsin.test_object() ) {
-        JsonObject jsobj = jsin.get_object();
-        jsobj.allow_omitted_members();
-        load( jsobj );
-    } else {
-        // This file is large enough that it's more than called for to minimize the
-        // amount of data written and read and make it a bit less "friendly",
-        // and use the streaming interface.
-        jsin.start_array();
-        tile_cache.clear();
-        jsin.start_array();
-        while( !jsin.end_array() ) {
-            jsin.start_array();
-            tripoint p;
-            p.x = jsin.get_int();
-            p.y = jsin.get_int();
-            p.z = jsin.get_int();
-            const std::string tile = jsin.get_string();
-            const int subtile = jsin.get_int();
-            const int rotation = jsin.get_int();
-            memorize_tile( std::numeric_limits<int>::max(), p,
-                           tile, subtile, rotation );
-            jsin.end_array();
-        }
-        symbol_cache.clear();
-        jsin.start_array();
-        while( !jsin.end_array() ) {
-            jsin.start_array();
-            tripoint p;
-            p.x = jsin.get_int();
-            p.y = jsin.get_int();
-            p.z = jsin.get_int();
-            const int symbol = jsin.get_int();
-            memorize_symbol( std::numeric_limits<int>::max(), p, symbol );
-            jsin.end_array();
-        }
-        jsin.end_array();
-    }
-}
-
-// Deserializer for legacy object-based memory map.
-void map_memory::load( const JsonObject &jsin )
-{
-    tile_cache.clear();
-    for( JsonObject pmap : jsin.get_array( "map_memory_tiles" ) ) {
-        pmap.allow_omitted_members();
-        const tripoint p( pmap.get_int( "x" ), pmap.get_int( "y" ), pmap.get_int( "z" ) );
-        memorize_tile( std::numeric_limits<int>::max(), p, pmap.get_string( "tile" ),
-                       pmap.get_int( "subtile" ), pmap.get_int( "rotation" ) );
-    }
-
-    symbol_cache.clear();
-    for( JsonObject pmap : jsin.get_array( "map_memory_curses" ) ) {
-        pmap.allow_omitted_members();
-        const tripoint p( pmap.get_int( "x" ), pmap.get_int( "y" ), pmap.get_int( "z" ) );
-        memorize_symbol( std::numeric_limits<int>::max(), p, pmap.get_int( "symbol" ) );
-    }
-}
-
 void point::deserialize( JsonIn &jsin )
 {
     jsin.start_array();
@@ -3792,7 +3700,8 @@ void cata_variant::deserialize( JsonIn &jsin )
 void event_multiset::serialize( JsonOut &jsout ) const
 {
     jsout.start_object();
-    std::vector<summaries_type::value_type> copy( summaries_.begin(), summaries_.end() );
+    const summaries_type &summaries = counts();
+    std::vector<summaries_type::value_type> copy( summaries.begin(), summaries.end() );
     jsout.member( "event_counts", copy );
     jsout.end_object();
 }
@@ -3802,6 +3711,7 @@ void event_multiset::deserialize( JsonIn &jsin )
     JsonObject jo = jsin.get_object();
     jo.allow_omitted_members();
     JsonArray events = jo.get_array( "event_counts" );
+    pending_.clear();
     if( !events.empty() && events.get_array( 0 ).has_int( 1 ) ) {
         // TEMPORARY until 0.F
         // Read legacy format with just ints
@@ -3818,6 +3728,10 @@ void event_multiset::deserialize( JsonIn &jsin )
         jo.read( "event_counts", copy );
         summaries_ = { copy.begin(), copy.end() };
     }
+    count_ = 0;
+    for( const summaries_type::value_type &p : summaries_ ) {
+        count_ += p.second.count;
+    }
 }
 
 void stats_tracker::serialize( JsonOut &jsout ) const
@@ -3933,12 +3847,13 @@ void submap::store( JsonOut &jsout ) const
     jsout.start_array();
     for( int j = 0; j < SEEY; j++ ) {
         for( int i = 0; i < SEEX; i++ ) {
-            if( itm[i][j].empty() ) {
+            const cata::colony<item> &items = itm.get( point( i, j ) );
+            if( items.empty() ) {
                 continue;
             }
             jsout.write( i );
             jsout.write( j );
-            jsout.write( itm[i][j] );
+            jsout.write( items );
         }
     }
     jsout.end_array();
@@ -3966,11 +3881,12 @@ void submap::store( JsonOut &jsout ) const
     for( int j = 0; j < SEEY; j++ ) {
         for( int i = 0; i < SEEX; i++ ) {
             // Save fields
-            if( fld[i][j].field_count() > 0 ) {
+            const field &f = fld.get( point( i, j ) );
+            if( f.field_count() > 0 ) {
                 jsout.write( i );
                 jsout.write( j );
                 jsout.start_array();
-                for( const auto &elem : fld[i][j] ) {
+                for( const auto &elem : f ) {
                     const field_entry &cur = elem.second;
                     jsout.write( cur.get_field_type().id() );
                     jsout.write( cur.get_field_intensity() );
@@ -4079,13 +3995,13 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
                     if( tid == ter_t_rubble ) {
                         ter[i][j] = ter_id( "t_dirt" );
                         frn[i][j] = furn_id( "f_rubble" );
-                        itm[i][j].insert( rock );
-                        itm[i][j].insert( rock );
+                        itm.get_or_add( point( i, j ) ).insert( rock );
+                        itm.get_or_add( point( i, j ) ).insert( rock );
                     } else if( tid == ter_t_wreckage ) {
                         ter[i][j] = ter_id( "t_dirt" );
                         frn[i][j] = furn_id( "f_wreckage" );
-                        itm[i][j].insert( chunk );
-                        itm[i][j].insert( chunk );
+                        itm.get_or_add( point( i, j ) ).insert( chunk );
+                        itm.get_or_add( point( i, j ) ).insert( chunk );
                     } else if( tid == ter_t_ash ) {
                         ter[i][j] = ter_id( "t_dirt" );
                         frn[i][j] = furn_id( "f_ash" );
@@ -4158,11 +4074,11 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
             int j = jsin.get_int();
             const point p( i, j );
 
-            if( !jsin.read( itm[p.x][p.y], false ) ) {
+            if( !jsin.read( itm.get_or_add( p ), false ) ) {
                 debugmsg( "Items array is corrupt in submap at: %s, skipping", p.to_string() );
             }
             // some portion could've been read even if error occurred
-            for( item &it : itm[p.x][p.y] ) {
+            for( item &it : itm.get_or_add( p ) ) {
                 if( it.is_emissive() ) {
                     update_lum_add( p, it );
                 }
@@ -4207,10 +4123,11 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
                 } else {
                     ft = field_types::get_field_type_by_legacy_enum( type_int ).id;
                 }
-                if( fld[i][j].find_field( ft ) == nullptr ) {
+                field &f = fld.get_or_add( point( i, j ) );
+                if( f.find_field( ft ) == nullptr ) {
                     field_count++;
                 }
-                fld[i][j].add_field( ft, intensity, time_duration::from_turns( age ) );
+                f.add_field( ft, intensity, time_duration::from_turns( age ) );
             }
         }
     } else if( member_name == "graffiti" ) {
@@ -16,6 +16,7 @@
 #include "map.h"
 #include "output.h"
 #include "point.h"
+#include "profiler.h"
 
 static constexpr int SCENT_RADIUS = 40;
 
@@ -161,6 +162,7 @@ bool scent_map::inbounds( const point &p ) const
 
 void scent_map::update( const tripoint &center, map &m )
 {
+    CATA_PROFILE_ZONE( "scent_map::update" );
     // Stop updating scent after X turns of the player not moving.
     // Once wind is added, need to reset this on wind shifts as well.
     if( !player_last_position || center != *player_last_position ) {
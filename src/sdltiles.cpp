@@ -728,12 +728,9 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
         }
     }
 
-    // TODO: Get this from UTF system to make sure it is exactly the kind of space we need
-    static const std::string space_string = " ";
-
     bool update = false;
     for( int j = 0; j < win->height; j++ ) {
-        if( !win->line[j].touched ) {
+        if( !win->line[j].touched() ) {
             continue;
         }
 
@@ -744,8 +741,11 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
         }
 
         update = true;
-        win->line[j].touched = false;
-        for( int i = 0; i < win->width; i++ ) {
+        // only the cells changed since the line was last drawn
+        const int dirty_begin = win->line[j].dirty_begin;
+        const int dirty_end = std::min( win->line[j].dirty_end, win->width );
+        win->line[j].untouch();
+        for( int i = dirty_begin; i < dirty_end; i++ ) {
             const int fbx = win->pos.x + i;
             if( fbx >= static_cast<int>( framebuffer[fby].chars.size() ) ) {
                 // prevent indexing outside the frame buffer. This might happen for some parts of the window.
@@ -770,26 +770,27 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
             }
             oldcell = cell;
 
-            if( cell.ch.empty() ) {
+            if( cell.empty() ) {
                 continue; // second cell of a multi-cell character
             }
 
             // Spaces are used a lot, so this does help noticeably
-            if( cell.ch == space_string ) {
+            if( cell.ch == ' ' ) {
                 geometry->rect( renderer, point( drawx, drawy ), font->width, font->height,
                                 color_as_sdl( cell.BG ) );
                 continue;
             }
-            const int codepoint = UTF8_getch( cell.ch );
+            const std::string ch = cell.str();
+            const int codepoint = cell.codepoint();
             const catacurses::base_color FG = cell.FG;
             const catacurses::base_color BG = cell.BG;
-            int cw = ( codepoint == UNKNOWN_UNICODE ) ? 1 : utf8_width( cell.ch );
+            int cw = ( codepoint == UNKNOWN_UNICODE ) ? 1 : utf8_width( ch );
             if( cw < 1 ) {
                 // utf8_width() may return a negative width
                 continue;
             }
             bool use_draw_ascii_lines_routine = get_option<bool>( "USE_DRAW_ASCII_LINES_ROUTINE" );
-            unsigned char uc = static_cast<unsigned char>( cell.ch[0] );
+            unsigned char uc = static_cast<unsigned char>( ch[0] );
             switch( codepoint ) {
                 case LINE_XOXO_UNICODE:
                     uc = LINE_XOXO_C;
@@ -836,7 +837,7 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
             if( use_draw_ascii_lines_routine ) {
                 font->draw_ascii_lines( renderer, geometry, uc, point( drawx, drawy ), FG );
             } else {
-                font->OutputChar( renderer, geometry, cell.ch, point( drawx, drawy ), FG );
+                font->OutputChar( renderer, geometry, ch, point( drawx, drawy ), FG );
             }
         }
     }
@@ -2500,6 +2501,9 @@ static void CheckMessages()
                 }
                 break;
             case SDL_RENDER_TARGETS_RESET:
+                if( tilecontext ) {
+                    tilecontext->invalidate_static_layers();
+                }
                 need_redraw = true;
                 needupdate = true;
                 break;
@@ -2,6 +2,8 @@
 #ifndef CATA_SRC_SIMPLE_PATHFINDING_H
 #define CATA_SRC_SIMPLE_PATHFINDING_H
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <queue>
 #include <vector>
@@ -37,6 +39,54 @@ struct path {
     std::vector<node<Point>> nodes;
 };
 
+// State of a square in a search.  The states are kept between searches, so that a search does
+// not allocate and clear a whole map: a square whose `search` is not the current one has not
+// been reached yet.
+struct search_cell {
+    int open = 0;
+    uint16_t search = 0;
+    int8_t dir = 0;
+    bool closed = false;
+};
+
+struct search_scratch {
+    std::vector<search_cell> cells;
+    uint16_t search = 0;
+
+    // Starts a search of a map of @p size squares.
+    void start( size_t size ) {
+        if( cells.size() < size ) {
+            cells.resize( size );
+        }
+        if( ++search == 0 ) {
+            std::fill( cells.begin(), cells.end(), search_cell() );
+            search = 1;
+        }
+    }
+
+    // Frees the cells, for threads that are done searching.
+    void release() {
+        std::vector<search_cell>().swap( cells );
+    }
+
+    search_cell &operator[]( int n ) {
+        search_cell &cell = cells[n];
+        if( cell.search != search ) {
+            cell = search_cell();
+            cell.search = search;
+        }
+        return cell;
+    }
+};
+
+// Overmaps are generated on worker threads too, hence one scratch per thread.  The main thread
+// keeps its scratch for the next search, workers release theirs when their task is done.
+inline search_scratch &get_search_scratch()
+{
+    static thread_local search_scratch scratch;
+    return scratch;
+}
+
 /**
  * @param source Starting point of path
  * @param dest End point of path
@@ -80,34 +130,33 @@ path<Point> find_path( const Point &source,
         return res;
     }
 
-    const size_t map_size = Traits::x( max ) * Traits::y( max );
-
-    std::vector<bool> closed( map_size, false );
-    std::vector<int> open( map_size, 0 );
-    std::vector<short> dirs( map_size, 0 );
-    std::priority_queue<Node, std::vector<Node>> nodes[2];
+    search_scratch &cells = get_search_scratch();
+    cells.start( static_cast<size_t>( Traits::x( max ) ) * Traits::y( max ) );
+    std::priority_queue<Node, std::vector<Node>> nodes;
 
-    int i = 0;
-    nodes[i].push( first_node );
-    open[map_index( source )] = std::numeric_limits<int>::max();
+    nodes.push( first_node );
+    cells[map_index( source )].open = std::numeric_limits<int>::max();
 
     // use A* to find the shortest path from (x1,y1) to (x2,y2)
-    while( !nodes[i].empty() ) {
-        const Node mn( nodes[i].top() ); // get the best-looking node
-
-        nodes[i].pop();
+    while( !nodes.empty() ) {
+        const Node mn( nodes.top() ); // get the best-looking node
+
+        nodes.pop();
+        search_cell &current = cells[map_index( mn.pos )];
+        // A node whose square got a better estimate after it was queued is left in the queue
+        // rather than searched for, skip it
+        if( current.closed ) {
+            continue;
+        }
         // mark it visited
-        closed[map_index( mn.pos )] = true;
+        current.closed = true;
 
         // if we've reached the end, draw the path and return
         if( mn.pos == dest ) {
             Point p = mn.pos;
 
-            res.nodes.reserve( nodes[i].size() );
-
             while( p != source ) {
-                const int n = map_index( p );
-                const int dir = dirs[n];
+                const int dir = cells[map_index( p )].dir;
                 res.nodes.emplace_back( p, dir );
                 p += four_adjacent_offsets[dir];
             }
@@ -119,11 +168,14 @@ path<Point> find_path( const Point &source,
 
         for( int dir = 0; dir < 4; dir++ ) {
             const Point p = mn.pos + four_adjacent_offsets[dir];
-            const int n = map_index( p );
             // don't allow:
             // * out of bounds
             // * already traversed tiles
-            if( !inbounds( p ) || closed[n] ) {
+            if( !inbounds( p ) ) {
+                continue;
+            }
+            search_cell &cell = cells[map_index( p )];
+            if( cell.closed ) {
                 continue;
             }
 
@@ -134,27 +186,10 @@ path<Point> find_path( const Point &source,
                 continue;
             }
             // record direction to shortest path
-            if( open[n] == 0 || open[n] > cn.priority ) {
-                dirs[n] = ( dir + 2 ) % 4;
-
-                if( open[n] != 0 ) {
-                    while( nodes[i].top().pos != p ) {
-                        nodes[1 - i].push( nodes[i].top() );
-                        nodes[i].pop();
-                    }
-                    nodes[i].pop();
-
-                    if( nodes[i].size() > nodes[1 - i].size() ) {
-                        i = 1 - i;
-                    }
-                    while( !nodes[i].empty() ) {
-                        nodes[1 - i].push( nodes[i].top() );
-                        nodes[i].pop();
-                    }
-                    i = 1 - i;
-                }
-                open[n] = cn.priority;
-                nodes[i].push( cn );
+            if( cell.open == 0 || cell.open > cn.priority ) {
+                cell.dir = static_cast<int8_t>( ( dir + 2 ) % 4 );
+                cell.open = cn.priority;
+                nodes.push( cn );
             }
         }
     }
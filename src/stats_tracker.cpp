@@ -86,17 +86,13 @@ void event_multiset::set_type( event_type type )
 
 int event_multiset::count() const
 {
-    int total = 0;
-    for( const auto &pair : summaries_ ) {
-        total += pair.second.count;
-    }
-    return total;
+    return count_;
 }
 
 int event_multiset::count( const cata::event::data_type &criteria ) const
 {
     int total = 0;
-    for( const auto &pair : summaries_ ) {
+    for( const auto &pair : counts() ) {
         if( event_data_matches( pair.first, criteria ) ) {
             total += pair.second.count;
         }
@@ -112,7 +108,7 @@ int event_multiset::total( const std::string &field ) const
 int event_multiset::total( const std::string &field, const cata::event::data_type &criteria ) const
 {
     int total = 0;
-    for( const auto &pair : summaries_ ) {
+    for( const auto &pair : counts() ) {
         auto it = pair.first.find( field );
         if( it == pair.first.end() ) {
             continue;
@@ -127,7 +123,7 @@ int event_multiset::total( const std::string &field, const cata::event::data_typ
 int event_multiset::minimum( const std::string &field ) const
 {
     int minimum = 0;
-    for( const auto &pair : summaries_ ) {
+    for( const auto &pair : counts() ) {
         auto it = pair.first.find( field );
         if( it == pair.first.end() ) {
             continue;
@@ -143,7 +139,7 @@ int event_multiset::minimum( const std::string &field ) const
 int event_multiset::maximum( const std::string &field ) const
 {
     int maximum = 0;
-    for( const auto &pair : summaries_ ) {
+    for( const auto &pair : counts() ) {
         auto it = pair.first.find( field );
         if( it == pair.first.end() ) {
             continue;
@@ -166,6 +162,7 @@ struct compare_times {
 
 cata::optional<event_multiset::summaries_type::value_type> event_multiset::first() const
 {
+    fold_pending();
     auto minimum = std::min_element( summaries_.begin(), summaries_.end(),
                                      compare_times<&event_summary::first>() );
     if( minimum == summaries_.end() ) {
@@ -176,6 +173,7 @@ cata::optional<event_multiset::summaries_type::value_type> event_multiset::first
 
 cata::optional<event_multiset::summaries_type::value_type> event_multiset::last() const
 {
+    fold_pending();
     auto minimum = std::max_element( summaries_.begin(), summaries_.end(),
                                      compare_times<&event_summary::last>() );
     if( minimum == summaries_.end() ) {
@@ -186,12 +184,33 @@ cata::optional<event_multiset::summaries_type::value_type> event_multiset::last(
 
 void event_multiset::add( const cata::event &e )
 {
-    summaries_[e.data()].add( e );
+    if( e.spec_fields() != nullptr ) {
+        // All events of a type made by event::make have the same fields
+        pending_fields_ = e.spec_fields();
+        pending_num_fields_ = e.num_fields();
+        pending_[e.values()].add( e );
+    } else {
+        summaries_[e.data()].add( e );
+    }
+    ++count_;
 }
 
 void event_multiset::add( const summaries_type::value_type &e )
 {
     summaries_[e.first].add( e.second );
+    count_ += e.second.count;
+}
+
+void event_multiset::fold_pending() const
+{
+    for( const auto &p : pending_ ) {
+        cata::event::data_type data;
+        for( size_t i = 0; i < pending_num_fields_; ++i ) {
+            data.emplace( pending_fields_[i].first, p.first[i] );
+        }
+        summaries_[data].add( p.second );
+    }
+    pending_.clear();
 }
 
 base_watcher::~base_watcher()
@@ -226,6 +245,12 @@ const cata_variant &stats_tracker_multiset_state::get_value() const
     abort();
 }
 
+const event_multiset &stats_tracker_value_state::get_events() const
+{
+    debugmsg( "Trying to get an event_multiset from a value state" );
+    abort();
+}
+
 stats_tracker::~stats_tracker()
 {
     unwatch_all();
@@ -239,11 +264,20 @@ event_multiset &stats_tracker::get_events( event_type type )
 event_multiset stats_tracker::get_events(
     const string_id<event_transformation> &transform_id )
 {
+    // A watched transformation is kept up to date as events arrive
+    auto it = event_transformation_states.find( transform_id );
+    if( it != event_transformation_states.end() ) {
+        return it->second->get_events();
+    }
     return transform_id->value( *this );
 }
 
 cata_variant stats_tracker::value_of( const string_id<event_statistic> &stat )
 {
+    auto it = stat_states.find( stat );
+    if( it != stat_states.end() ) {
+        return it->second->get_value();
+    }
     return stat->value( *this );
 }
 
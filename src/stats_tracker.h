@@ -1,6 +1,7 @@
 #ifndef CATA_SRC_STATS_TRACKER_H
 #define CATA_SRC_STATS_TRACKER_H
 
+#include <cstddef>
 #include <iosfwd>
 #include <memory>
 #include <set>
@@ -32,11 +33,16 @@ class stats_tracker;
 // The stats_tracker is intended to keep a summary of events that have occurred.
 // For each event_type it stores an event_multiset.
 // Within the event_tracker, the events are partitioned according to their data
-// (an event::data_type object, which is a map of keys to values).
+// (an event::data_type object, which is a map of keys to values).  Events made
+// by event::make are first partitioned by their values alone, and only put in
+// that form when the event_multiset is read or saved.
 // Within each partition, an event_summary is stored, which contains the first
 // and last times such events were seen, and the number of them seen.
 // The stats_tracker can be queried in various ways to get summary statistics
 // about events that have occurred.
+// Statistics and transformations which are watched keep a state that is
+// updated as each event arrives, and queries about them are answered from
+// that state rather than by going over all the events again.
 
 struct event_summary {
     event_summary();
@@ -67,6 +73,7 @@ class event_multiset
         void set_type( event_type );
 
         const summaries_type &counts() const {
+            fold_pending();
             return summaries_;
         }
 
@@ -99,8 +106,19 @@ class event_multiset
         void serialize( JsonOut & ) const;
         void deserialize( JsonIn & );
     private:
+        // Moves the summaries in pending_ to summaries_
+        void fold_pending() const;
+
         event_type type_;
-        summaries_type summaries_;
+        mutable summaries_type summaries_;
+        // Summaries of events made by event::make, by the values of their fields
+        mutable std::unordered_map<cata::event::values_type, event_summary, cata::range_hash>
+        pending_;
+        // The fields of the events in pending_
+        const cata::event::field_type *pending_fields_ = nullptr;
+        size_t pending_num_fields_ = 0;
+        // Sum of the counts of all the summaries
+        int count_ = 0;
 };
 
 class base_watcher
@@ -170,11 +188,13 @@ class stats_tracker_state
     public:
         virtual ~stats_tracker_state() = 0;
         virtual const cata_variant &get_value() const = 0;
+        virtual const event_multiset &get_events() const = 0;
 };
 
 class stats_tracker_value_state : public stats_tracker_state
 {
     public:
+        [[noreturn]] const event_multiset &get_events() const override;
 };
 
 class stats_tracker_multiset_state : public stats_tracker_state
@@ -1,11 +1,22 @@
+#include <array>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
+
+#include "cata_assert.h"
 #include "string_id.h"
 
 namespace
 {
 using InternMapType = std::unordered_map<std::string, int>;
-using ReverseLookupVecType = std::vector<const std::string *>;
+// Interned strings are looked up by id in fixed size blocks that never move once
+// allocated, so reading the string of an id needs no lock even while another
+// thread interns a new string.
+constexpr int reverse_lookup_block_bits = 12;
+constexpr int reverse_lookup_block_size = 1 << reverse_lookup_block_bits;
+using ReverseLookupBlock = std::array<const std::string *, reverse_lookup_block_size>;
+using ReverseLookupType = std::array<std::unique_ptr<ReverseLookupBlock>, 4096>;
 } // namespace
 
 inline static InternMapType &get_intern_map()
@@ -14,19 +25,33 @@ inline static InternMapType &get_intern_map()
     return map;
 }
 
-inline static ReverseLookupVecType &get_reverse_lookup_vec()
+inline static ReverseLookupType &get_reverse_lookup()
+{
+    static ReverseLookupType blocks{};
+    return blocks;
+}
+
+// Guards the intern map and adding to the reverse lookup.
+inline static std::mutex &get_intern_mutex()
 {
-    static ReverseLookupVecType vec{};
-    return vec;
+    static std::mutex mutex;
+    return mutex;
 }
 
 template<typename S>
 inline static int universal_string_id_intern( S &&s )
 {
-    int next_id = get_reverse_lookup_vec().size();
+    std::lock_guard<std::mutex> lock( get_intern_mutex() );
+    const int next_id = get_intern_map().size();
     const auto &pair = get_intern_map().emplace( std::forward<S>( s ), next_id );
     if( pair.second ) { // inserted
-        get_reverse_lookup_vec().push_back( &pair.first->first );
+        const size_t block_index = next_id >> reverse_lookup_block_bits;
+        cata_assert( block_index < get_reverse_lookup().size() );
+        std::unique_ptr<ReverseLookupBlock> &block = get_reverse_lookup()[block_index];
+        if( !block ) {
+            block = std::make_unique<ReverseLookupBlock>();
+        }
+        ( *block )[next_id & ( reverse_lookup_block_size - 1 )] = &pair.first->first;
     }
     return pair.first->second;
 }
@@ -48,7 +73,8 @@ int string_identity_static::string_id_intern( std::string &&s )
 
 const std::string &string_identity_static::get_interned_string( int id )
 {
-    return *get_reverse_lookup_vec()[id];
+    return *( *get_reverse_lookup()[id >> reverse_lookup_block_bits] )[id &
+            ( reverse_lookup_block_size - 1 )];
 }
 
 int string_identity_static::empty_interned_string()
@@ -19,8 +19,8 @@ void maptile_soa<sx, sy>::swap_soa_tile( const point &p1, const point &p2 )
     std::swap( ter[p1.x][p1.y], ter[p2.x][p2.y] );
     std::swap( frn[p1.x][p1.y], frn[p2.x][p2.y] );
     std::swap( lum[p1.x][p1.y], lum[p2.x][p2.y] );
-    std::swap( itm[p1.x][p1.y], itm[p2.x][p2.y] );
-    std::swap( fld[p1.x][p1.y], fld[p2.x][p2.y] );
+    itm.swap( p1, p2 );
+    fld.swap( p1, p2 );
     std::swap( trp[p1.x][p1.y], trp[p2.x][p2.y] );
     std::swap( rad[p1.x][p1.y], rad[p2.x][p2.y] );
 }
@@ -41,6 +41,31 @@ submap::~submap() = default;
 
 submap &submap::operator=( submap && ) = default;
 
+size_t submap::memory_usage() const
+{
+    size_t result = sizeof( submap );
+    itm.for_each( [&result]( const cata::colony<item> &items ) {
+        result += sizeof( items ) + items.size() * sizeof( item );
+    } );
+    fld.for_each( [&result]( const field &f ) {
+        result += sizeof( f ) + f.field_count() * sizeof( field_entry );
+    } );
+    for( const std::unique_ptr<vehicle> &veh : vehicles ) {
+        result += sizeof( vehicle ) + veh->part_count() * sizeof( vehicle_part );
+    }
+    return result;
+}
+
+void submap::release_empty_squares()
+{
+    itm.release_if( []( const cata::colony<item> &items ) {
+        return items.empty();
+    } );
+    fld.release_if( []( const field &f ) {
+        return f.field_count() == 0;
+    } );
+}
+
 static const std::string COSMETICS_GRAFFITI( "GRAFFITI" );
 static const std::string COSMETICS_SIGNAGE( "SIGNAGE" );
 // Handle GCC warning: 'warning: returning reference to temporary'
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_SUBMAP_H
 #define CATA_SRC_SUBMAP_H
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <iosfwd>
@@ -9,6 +10,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "active_item_cache.h"
@@ -48,13 +50,90 @@ struct spawn_point {
         mission_id( MIS ), friendly( F ), name( N ), data( SD ) {}
 };
 
+/**
+ * Storage for something most squares of a submap do not have, like items or fields.
+ *
+ * Only the squares that were accessed mutably have an element.  Each is allocated on its own,
+ * so references to it stay valid while other squares are added, and the submap only holds a
+ * byte per square to find them.  Reading a square without an element gives a shared empty one.
+ */
+template<typename T, int sx, int sy>
+class sparse_tile_data
+{
+        static_assert( sx * sy < 255, "too many squares to index with a byte" );
+    public:
+        const T &get( const point &p ) const {
+            const std::uint8_t s = slots[p.x][p.y];
+            if( s == 0 ) {
+                static const T empty;
+                return empty;
+            }
+            return *elements[s - 1];
+        }
+
+        /** The element of the square, null if it has none. */
+        T *find( const point &p ) {
+            const std::uint8_t s = slots[p.x][p.y];
+            return s == 0 ? nullptr : elements[s - 1].get();
+        }
+
+        T &get_or_add( const point &p ) {
+            std::uint8_t &s = slots[p.x][p.y];
+            if( s == 0 ) {
+                elements.push_back( std::make_unique<T>() );
+                s = static_cast<std::uint8_t>( elements.size() );
+            }
+            return *elements[s - 1];
+        }
+
+        void swap( const point &p1, const point &p2 ) {
+            std::swap( slots[p1.x][p1.y], slots[p2.x][p2.y] );
+        }
+
+        template<typename Fn>
+        void for_each( Fn fn ) const {
+            for( const std::unique_ptr<T> &e : elements ) {
+                fn( *e );
+            }
+        }
+
+        /**
+         * Frees the elements @p is_empty returns true for.  This invalidates references to
+         * them, so it must not be called while any might be held.
+         */
+        template<typename Pred>
+        void release_if( Pred is_empty ) {
+            for( int x = 0; x < sx; x++ ) {
+                for( int y = 0; y < sy; y++ ) {
+                    std::uint8_t &s = slots[x][y];
+                    if( s == 0 || !is_empty( *elements[s - 1] ) ) {
+                        continue;
+                    }
+                    // Move the last element in the freed place
+                    const std::uint8_t last = static_cast<std::uint8_t>( elements.size() );
+                    if( s != last ) {
+                        std::swap( elements[s - 1], elements[last - 1] );
+                        *std::find( &slots[0][0], &slots[0][0] + sx * sy, last ) = s;
+                    }
+                    elements.pop_back();
+                    s = 0;
+                }
+            }
+        }
+
+    private:
+        // Index + 1 in elements of the element of each square, 0 if it has none.
+        std::uint8_t slots[sx][sy] = {};
+        std::vector<std::unique_ptr<T>> elements;
+};
+
 template<int sx, int sy>
 struct maptile_soa {
     ter_id             ter[sx][sy];  // Terrain on each square
     furn_id            frn[sx][sy];  // Furniture on each square
     std::uint8_t       lum[sx][sy];  // Number of items emitting light on each square
-    cata::colony<item> itm[sx][sy];  // Items on each square
-    field              fld[sx][sy];  // Field on each square
+    sparse_tile_data<cata::colony<item>, sx, sy> itm; // Items on each square
+    sparse_tile_data<field, sx, sy> fld; // Field on each square
     trap_id            trp[sx][sy];  // Trap on each square
     int                rad[sx][sy];  // Irradiation of each square
 
@@ -146,7 +225,7 @@ class submap : maptile_soa<SEEX, SEEY>
             // Have to scan through all items to be sure removing i will actually lower
             // the count below 255.
             int count = 0;
-            for( const auto &it : itm[p.x][p.y] ) {
+            for( const auto &it : itm.get( p ) ) {
                 if( it.is_emissive() ) {
                     count++;
                 }
@@ -159,22 +238,41 @@ class submap : maptile_soa<SEEX, SEEY>
 
         // TODO: Replace this as it essentially makes itm public
         cata::colony<item> &get_items( const point &p ) {
-            return itm[p.x][p.y];
+            return itm.get_or_add( p );
         }
 
         const cata::colony<item> &get_items( const point &p ) const {
-            return itm[p.x][p.y];
+            return itm.get( p );
+        }
+
+        /** The items of a square that may be changed, null if nothing was ever put there. */
+        cata::colony<item> *get_items_if_any( const point &p ) {
+            return itm.find( p );
         }
 
         // TODO: Replace this as it essentially makes fld public
         field &get_field( const point &p ) {
-            return fld[p.x][p.y];
+            return fld.get_or_add( p );
         }
 
         const field &get_field( const point &p ) const {
-            return fld[p.x][p.y];
+            return fld.get( p );
+        }
+
+        /** The field of a square that may be changed, null if it never had one. */
+        field *get_field_if_any( const point &p ) {
+            return fld.find( p );
         }
 
+        /**
+         * Frees the storage of the squares which have no items or fields.  References to
+         * the items and fields of the submap may not be held while calling this.
+         */
+        void release_empty_squares();
+
+        /** Rough estimate of the memory the submap and its contents use, in bytes. */
+        size_t memory_usage() const;
+
         struct cosmetic_t {
             point pos;
             std::string type;
@@ -272,6 +370,11 @@ struct maptile {
 
         maptile( submap *sub, const point &p ) :
             sm( sub ), pos_( p ) { }
+
+        // For reading items and fields without giving the square storage for them
+        const submap &get_submap() const {
+            return *sm;
+        }
     public:
         inline point pos() const {
             return pos_;
@@ -301,11 +404,12 @@ struct maptile {
         }
 
         const field &get_field() const {
-            return sm->get_field( pos() );
+            return get_submap().get_field( pos() );
         }
 
         field_entry *find_field( const field_type_id &field_to_find ) {
-            return sm->get_field( pos() ).find_field( field_to_find );
+            field *const fields = sm->get_field_if_any( pos() );
+            return fields == nullptr ? nullptr : fields->find_field( field_to_find );
         }
 
         int get_radiation() const {
@@ -330,12 +434,12 @@ struct maptile {
 
         // For map::draw_maptile
         size_t get_item_count() const {
-            return sm->get_items( pos() ).size();
+            return get_submap().get_items( pos() ).size();
         }
 
         // Assumes there is at least one item
         const item &get_uppermost_item() const {
-            return *std::prev( sm->get_items( pos() ).cend() );
+            return *std::prev( get_submap().get_items( pos() ).cend() );
         }
 };
 
@@ -35,6 +35,7 @@
 #include "options.h"
 #include "overmap.h"
 #include "overmapbuffer.h"
+#include "profiler.h"
 #include "regional_settings.h"
 #include "ret_val.h"
 #include "rng.h"
@@ -1048,6 +1049,7 @@ const weather_generator &weather_manager::get_cur_weather_gen() const
 
 void weather_manager::update_weather()
 {
+    CATA_PROFILE_ZONE( "weather_manager::update_weather" );
     w_point &w = *weather_precise;
     winddirection = wind_direction_override ? *wind_direction_override : w.winddirection;
     windspeed = windspeed_override ? *windspeed_override : w.windpower;
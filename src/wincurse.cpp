@@ -5,6 +5,7 @@
 #endif
 #include "cursesport.h" // IWYU pragma: associated
 
+#include <algorithm>
 #include <cstdlib>
 #include <fstream>
 
@@ -443,12 +444,15 @@ void cata_cursesport::curses_drawwindow( const catacurses::window &w )
     wchar_t tmp;
 
     for( j = 0; j < win->height; j++ ) {
-        if( win->line[j].touched ) {
-            win->line[j].touched = false;
+        if( win->line[j].touched() ) {
+            // only the cells changed since the line was last drawn
+            const int dirty_end = std::min( win->line[j].dirty_end, win->width );
+            i = win->line[j].dirty_begin;
+            win->line[j].untouch();
 
-            for( i = 0; i < win->width; i++ ) {
+            for( ; i < dirty_end; i++ ) {
                 const cursecell &cell = win->line[j].chars[i];
-                if( cell.ch.empty() ) {
+                if( cell.empty() ) {
                     // second cell of a multi-cell character
                     continue;
                 }
@@ -462,13 +466,12 @@ void cata_cursesport::curses_drawwindow( const catacurses::window &w )
                 int FG = cell.FG;
                 int BG = cell.BG;
                 FillRectDIB( drawx, drawy, fontwidth, fontheight, BG );
-                static const std::string space_string = " ";
                 // Spaces don't need any drawing except background
-                if( cell.ch == space_string ) {
+                if( cell.ch == ' ' ) {
                     continue;
                 }
 
-                tmp = UTF8_getch( cell.ch );
+                tmp = cell.codepoint();
                 if( tmp != UNKNOWN_UNICODE ) {
 
                     int color = RGB( windowsPalette[FG].rgbRed, windowsPalette[FG].rgbGreen,
@@ -481,11 +484,11 @@ void cata_cursesport::curses_drawwindow( const catacurses::window &w )
                         i += cw - 1;
                     }
                     if( tmp ) {
-                        const std::wstring utf16 = widen( cell.ch );
+                        const std::wstring utf16 = widen( cell.str() );
                         ExtTextOutW( backbuffer, drawx, drawy, 0, nullptr, utf16.c_str(), utf16.length(), nullptr );
                     }
                 } else {
-                    switch( static_cast<unsigned char>( win->line[j].chars[i].ch[0] ) ) {
+                    switch( static_cast<unsigned char>( cell.str()[0] ) ) {
                         // box bottom/top side (horizontal line)
                         case LINE_OXOX_C:
                             HorzLineDIB( drawx, drawy + halfheight, drawx + fontwidth, 1, FG );
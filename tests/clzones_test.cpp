@@ -1,4 +1,5 @@
 #include <iosfwd>
+#include <unordered_set>
 #include <vector>
 
 #include "catch/catch.hpp"
@@ -238,3 +239,35 @@ TEST_CASE( "zone sorting comestibles ", "[zones][items][food][activities]" )
         }
     }
 }
+
+TEST_CASE( "zone queries by area", "[zones]" )
+{
+    clear_map();
+    zone_manager &zm = zone_manager::get_manager();
+    const tripoint start( 10, 10, 0 );
+    const tripoint end( 14, 12, 0 );
+    zm.add( "Food", zone_type_LOOT_FOOD, faction_id( "your_followers" ), false, true, start, end );
+
+    CHECK( zm.has( zone_type_LOOT_FOOD, start ) );
+    CHECK( zm.has( zone_type_LOOT_FOOD, tripoint( 12, 11, 0 ) ) );
+    CHECK_FALSE( zm.has( zone_type_LOOT_FOOD, tripoint( 15, 11, 0 ) ) );
+    CHECK_FALSE( zm.has( zone_type_LOOT_FOOD, tripoint( 12, 11, 1 ) ) );
+    CHECK_FALSE( zm.has( zone_type_LOOT_DRINK, start ) );
+
+    CHECK( zm.has_near( zone_type_LOOT_FOOD, tripoint( 20, 11, 0 ), 6 ) );
+    CHECK_FALSE( zm.has_near( zone_type_LOOT_FOOD, tripoint( 20, 11, 0 ), 5 ) );
+    // only the same z-level counts as near
+    CHECK_FALSE( zm.has_near( zone_type_LOOT_FOOD, tripoint( 12, 11, 1 ), 5 ) );
+
+    // the whole zone, then only its x = 14 column, the one within 2 of x = 16
+    CHECK( zm.get_near( zone_type_LOOT_FOOD, tripoint( 12, 11, 0 ), 10 ).size() == 15 );
+    const std::unordered_set<tripoint> east_column {
+        tripoint( 14, 10, 0 ), tripoint( 14, 11, 0 ), tripoint( 14, 12, 0 )
+    };
+    CHECK( zm.get_near( zone_type_LOOT_FOOD, tripoint( 16, 11, 0 ), 2 ) == east_column );
+    CHECK( zm.get_near( zone_type_LOOT_FOOD, tripoint( 20, 11, 0 ), 2 ).empty() );
+
+    CHECK( zm.get_nearest( zone_type_LOOT_FOOD, tripoint( 20, 5, 0 ), 10 ) ==
+           cata::optional<tripoint>( tripoint( 14, 10, 0 ) ) );
+    CHECK_FALSE( zm.get_nearest( zone_type_LOOT_FOOD, tripoint( 20, 5, 0 ), 5 ) );
+}
@@ -83,3 +83,63 @@ TEST_CASE( "mutation enchantments", "[enchantments][mutations]" )
 
     test_generic_ench( p, str_before );
 }
+
+TEST_CASE( "enchantment cache follows worn items", "[enchantments][worn][items]" )
+{
+    avatar p;
+    clear_character( p );
+
+    int str_before = p.get_str();
+
+    item &ring = p.i_add( item( "test_ring_strength_1" ) );
+    p.wear( item_location( *p.as_character(), &ring ), false );
+
+    // no explicit recalculation, wearing the ring invalidated the cache
+    p.update_enchantment_cache();
+    p.process_turn();
+    CHECK( p.get_str() == str_before + 1 );
+
+    item &worn_ring = p.worn.back();
+    REQUIRE( worn_ring.typeId() == itype_id( "test_ring_strength_1" ) );
+    p.i_rem( &worn_ring );
+
+    p.update_enchantment_cache();
+    p.process_turn();
+    CHECK( p.get_str() == str_before );
+}
+
+TEST_CASE( "enchantment cache follows mutations and bionics", "[enchantments][mutations][bionics]" )
+{
+    avatar p;
+    clear_character( p );
+
+    int str_before = p.get_str();
+
+    SECTION( "gaining and losing a mutation" ) {
+        const trait_id test_ink( "TEST_ENCH_MUTATION" );
+        p.set_mutation( test_ink );
+        p.update_enchantment_cache();
+        p.process_turn();
+        CHECK( p.get_str() == str_before + p.get_str_base() * 2 + 25 );
+
+        p.unset_mutation( test_ink );
+        p.update_enchantment_cache();
+        p.process_turn();
+        CHECK( p.get_str() == str_before );
+    }
+
+    SECTION( "installing and removing a bionic" ) {
+        const bionic_id test_bio( "test_bio_ench" );
+        p.set_max_power_level( 100_kJ );
+        p.set_power_level( 100_kJ );
+        give_and_activate_bionic( p, test_bio );
+        p.update_enchantment_cache();
+        p.process_turn();
+        CHECK( p.get_str() == str_before + p.get_str_base() * 2 + 25 );
+
+        p.remove_bionic( test_bio );
+        p.update_enchantment_cache();
+        p.process_turn();
+        CHECK( p.get_str() == str_before );
+    }
+}
@@ -91,3 +91,44 @@ TEST_CASE( "notify_subscriber_2", "[event]" )
     sub.notify( original_event );
     REQUIRE( sub.found );
 }
+
+TEST_CASE( "event_fields_by_index", "[event]" )
+{
+    constexpr size_t victim_type =
+        cata::event::field_index<event_type::character_kills_monster>( "victim_type" );
+    static_assert( victim_type == 1, "fields are in the order of the event_spec" );
+
+    cata::event e = cata::event::make<event_type::character_kills_monster>(
+                        character_id( 7 ), mtype_id( "zombie" ) );
+    REQUIRE( e.num_fields() == 2 );
+    CHECK( std::string( e.field_name( 0 ) ) == "killer" );
+    CHECK( e.get<character_id>( 0 ) == character_id( 7 ) );
+    CHECK( e.get<mtype_id>( victim_type ) == mtype_id( "zombie" ) );
+    CHECK( e.get_variant_or_void( "no_such_field" ).type() == cata_variant_type::void_ );
+
+    const cata::event::data_type &data = e.data();
+    CHECK( data.size() == 2 );
+    CHECK( data.at( "killer" ).get<character_id>() == character_id( 7 ) );
+    // built once and kept with the event
+    CHECK( &e.data() == &data );
+}
+
+TEST_CASE( "subscribe_to_some_event_types", "[event]" )
+{
+    event_bus bus;
+    test_subscriber all;
+    test_subscriber kills;
+    bus.subscribe( &all );
+    bus.subscribe( &kills, { event_type::character_kills_monster } );
+
+    bus.send<event_type::character_kills_monster>( character_id( 5 ), mtype_id( "zombie" ) );
+    bus.send<event_type::awakes_dark_wyrms>();
+    CHECK( all.events.size() == 2 );
+    REQUIRE( kills.events.size() == 1 );
+    CHECK( kills.events[0].type() == event_type::character_kills_monster );
+
+    bus.unsubscribe( &kills );
+    bus.send<event_type::character_kills_monster>( character_id( 5 ), mtype_id( "zombie" ) );
+    CHECK( all.events.size() == 3 );
+    CHECK( kills.events.size() == 1 );
+}
@@ -156,3 +156,25 @@ TEST_CASE( "grenade_vs_vehicle", "[grenade],[explosion],[balance]" )
 {
     check_vehicle_damage( "grenade_act", "car", 5 );
 }
+
+TEST_CASE( "blast_is_stopped_by_walls", "[explosion]" )
+{
+    clear_map_and_put_player_underground();
+    map &here = get_map();
+    const tripoint origin( 30, 30, 0 );
+    // A wall too strong for the blast north of it, long enough that the blast
+    // dies out before it gets around.
+    for( int x = 15; x <= 45; x++ ) {
+        here.ter_set( tripoint( x, 28, 0 ), ter_id( "t_concrete_wall" ) );
+    }
+    monster &sheltered = spawn_test_monster( "mon_zombie", origin + tripoint( 0, -3, 0 ) );
+    monster &exposed = spawn_test_monster( "mon_zombie", origin + tripoint( 0, 3, 0 ) );
+
+    // Weak enough that it does not spread 9 squares, the way over the wall.
+    explosion_handler::explosion( origin, 105.0f, 0.8f );
+    explosion_handler::process_explosions();
+
+    CHECK( here.ter( tripoint( 30, 28, 0 ) ) == ter_id( "t_concrete_wall" ) );
+    CHECK( sheltered.get_hp() == sheltered.get_hp_max() );
+    CHECK( exposed.get_hp() < exposed.get_hp_max() );
+}
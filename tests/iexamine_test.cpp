@@ -1,7 +1,13 @@
 #include "catch/catch.hpp"
 
+#include "calendar.h"
 #include "iexamine.h"
+#include "item.h"
+#include "map.h"
+#include "map_helpers.h"
 #include "mapdata.h"
+#include "point.h"
+#include "type_id.h"
 
 TEST_CASE( "mapdata_examine" )
 {
@@ -13,3 +19,24 @@ TEST_CASE( "mapdata_examine" )
     CHECK_FALSE( data.has_examine( iexamine::dirtmound ) );
     CHECK_FALSE( data.has_examine( iexamine::none ) );
 }
+
+TEST_CASE( "pour_into_empty_keg" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint keg( 60, 60, 0 );
+    here.furn_set( keg, furn_id( "f_wood_keg" ) );
+    REQUIRE( iexamine::has_keg( keg ) );
+    REQUIRE( here.i_at( keg ).empty() );
+
+    item water( "water_clean", calendar::turn, 10 );
+    REQUIRE( iexamine::pour_into_keg( keg, water ) );
+    CHECK( water.charges == 0 );
+    map_stack stack = here.i_at( keg );
+    REQUIRE( stack.size() == 1 );
+    CHECK( stack.only_item().typeId() == itype_id( "water_clean" ) );
+    CHECK( stack.only_item().charges == 10 );
+
+    here.i_clear( keg );
+    here.furn_set( keg, furn_id( "f_null" ) );
+}
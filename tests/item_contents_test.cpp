@@ -4,6 +4,7 @@
 #include "item.h"
 #include "item_contents.h"
 #include "item_pocket.h"
+#include "item_size_cache.h"
 #include "itype.h"
 #include "map.h"
 #include "point.h"
@@ -100,3 +101,28 @@ TEST_CASE( "overflow test", "[item]" )
     purse.contents.overflow( origin );
     CHECK( here.i_at( origin ).size() == 1 );
 }
+
+TEST_CASE( "item size cache only lives as long as its scope", "[item]" )
+{
+    item tool_belt( "test_tool_belt" );
+    REQUIRE( tool_belt.put_in( item( "hammer" ), item_pocket::pocket_type::CONTAINER ).success() );
+    const units::mass weight_with_hammer = tool_belt.weight();
+    const units::volume volume_with_hammer = tool_belt.volume();
+
+    {
+        const item_size_cache::scope outer;
+        CHECK( tool_belt.weight() == weight_with_hammer );
+        {
+            const item_size_cache::scope inner;
+            CHECK( tool_belt.weight() == weight_with_hammer );
+            CHECK( tool_belt.volume() == volume_with_hammer );
+        }
+        // still cached by the outer scope
+        CHECK( tool_belt.volume() == volume_with_hammer );
+    }
+
+    REQUIRE( tool_belt.put_in( item( "wrench" ), item_pocket::pocket_type::CONTAINER ).success() );
+    CHECK( tool_belt.weight() == weight_with_hammer + item( "wrench" ).weight() );
+    const item_size_cache::scope scope;
+    CHECK( tool_belt.weight() == weight_with_hammer + item( "wrench" ).weight() );
+}
@@ -5,16 +5,23 @@
 #include <initializer_list>
 #include <limits>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "calendar.h"
 #include "enums.h"
+#include "flag.h"
+#include "flag_bitset.h"
 #include "item_factory.h"
 #include "item_pocket.h"
+#include "item_var_map.h"
 #include "itype.h"
+#include "json.h"
 #include "math_defines.h"
 #include "monstergenerator.h"
 #include "mtype.h"
+#include "point.h"
 #include "ret_val.h"
 #include "type_id.h"
 #include "units.h"
@@ -286,3 +293,77 @@ TEST_CASE( "items spawn in their default containers", "[item]" )
     check_spawning_in_container( "chem_black_powder" );
     check_spawning_in_container( "software_useless" );
 }
+
+TEST_CASE( "item flags from the type and the item itself", "[item][flags]" )
+{
+    item lamp( "atomic_lamp" );
+    REQUIRE( lamp.type->get_flags().count( flag_RADIOACTIVE ) );
+    CHECK( lamp.type->has_flag( flag_RADIOACTIVE ) );
+    CHECK( lamp.has_flag( flag_RADIOACTIVE ) );
+    CHECK_FALSE( lamp.has_own_flag( flag_RADIOACTIVE ) );
+    CHECK_FALSE( lamp.type->has_flag( flag_WET ) );
+
+    CHECK_FALSE( lamp.has_flag( flag_WET ) );
+    lamp.set_flag( flag_WET );
+    CHECK( lamp.has_own_flag( flag_WET ) );
+    CHECK( lamp.has_flag( flag_WET ) );
+
+    // copies carry the flags along
+    const item copy = lamp;
+    CHECK( copy.has_flag( flag_WET ) );
+
+    lamp.unset_flag( flag_WET );
+    CHECK_FALSE( lamp.has_flag( flag_WET ) );
+    CHECK( copy.has_flag( flag_WET ) );
+
+    lamp.set_flag( flag_WET );
+    lamp.unset_flags();
+    CHECK_FALSE( lamp.has_flag( flag_WET ) );
+    CHECK( lamp.has_flag( flag_RADIOACTIVE ) );
+
+    // a flag resolved once can be tested by its bit
+    const int radioactive = flag_bitset::bit_of( flag_RADIOACTIVE );
+    REQUIRE( radioactive >= 0 );
+    CHECK( lamp.type->has_flag( flag_RADIOACTIVE, radioactive ) );
+    CHECK( flag_bitset::bit_of( flag_id( "NOT_A_REAL_FLAG" ) ) == -1 );
+}
+
+TEST_CASE( "item variables round trip through the save format", "[item]" )
+{
+    item_var_map vars;
+    vars.set( "count", 42LL );
+    vars.set( "ratio", 0.1234567 );
+    vars.set( "where", tripoint( 1, -2, 3 ) );
+    vars.set( "name", std::string( "a thing" ) );
+    vars.set( "numeric_text", std::string( "17" ) );
+
+    CHECK( vars.get( "count", 0.0 ) == 42 );
+    CHECK( vars.get( "count", std::string() ) == "42" );
+    // doubles are rounded the way they are saved
+    CHECK( vars.get( "ratio", std::string() ) == "0.123457" );
+    CHECK( vars.get( "ratio", 0.0 ) == Approx( 0.123457 ) );
+    CHECK( vars.get( "where", tripoint_zero ) == tripoint( 1, -2, 3 ) );
+    CHECK( vars.get( "where", std::string() ) == "1,-2,3" );
+    CHECK( vars.get( "name", std::string() ) == "a thing" );
+    CHECK( vars.get( "numeric_text", 0.0 ) == 17 );
+    CHECK( vars.get( "missing", 5.0 ) == 5 );
+    CHECK_FALSE( vars.has( "missing" ) );
+
+    std::ostringstream os;
+    JsonOut jsout( os );
+    vars.serialize( jsout );
+    CHECK( os.str() == R"({"count":"42","name":"a thing","numeric_text":"17",)"
+           R"("ratio":"0.123457","where":"1,-2,3"})" );
+
+    std::istringstream is( os.str() );
+    JsonIn jsin( is );
+    item_var_map loaded;
+    loaded.deserialize( jsin );
+    CHECK( loaded == vars );
+    CHECK( loaded.as_strings() == vars.as_strings() );
+    CHECK( loaded.get( "where", tripoint_zero ) == tripoint( 1, -2, 3 ) );
+
+    loaded.erase( "count" );
+    CHECK_FALSE( loaded.has( "count" ) );
+    CHECK( loaded != vars );
+}
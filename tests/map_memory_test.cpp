@@ -4,11 +4,13 @@
 #include <type_traits>
 
 #include "catch/catch.hpp"
+#include "filesystem.h"
 #include "game_constants.h"
 #include "json.h"
 #include "lru_cache.h"
 #include "map.h"
 #include "map_memory.h"
+#include "path_info.h"
 #include "point.h"
 
 static constexpr tripoint p1{ tripoint_above };
@@ -89,6 +91,87 @@ TEST_CASE( "map_memory_survives_save_lod", "[map_memory]" )
     CHECK( memory.get_symbol( p3 ) == memory2.get_symbol( p3 ) );
 }
 
+TEST_CASE( "map_memory_forgets_whole_chunks", "[map_memory]" )
+{
+    map_memory memory;
+    const tripoint a( 0, 0, 0 );
+    const tripoint a2( SEEX - 1, SEEY - 1, 0 );
+    const tripoint b( SEEX, 0, 0 );
+    const tripoint c( -1, 0, 0 );
+    memory.memorize_tile( 2, a, "t_floor", 1, 2 );
+    memory.memorize_tile( 2, a2, "t_wall", 0, 0 );
+    memory.memorize_tile( 2, b, "t_floor", 1, 2 );
+    // a and a2 share a chunk, touching it again makes b the least recent one
+    memory.memorize_symbol( 2, a, 7 );
+    memory.memorize_symbol( 2, c, 8 );
+    CHECK( memory.get_tile( a ).tile == "t_floor" );
+    CHECK( memory.get_tile( a ).subtile == 1 );
+    CHECK( memory.get_tile( a ).rotation == 2 );
+    CHECK( memory.get_tile( a2 ).tile == "t_wall" );
+    CHECK( memory.get_symbol( a ) == 7 );
+    CHECK( memory.get_symbol( c ) == 8 );
+    CHECK( memory.get_tile( b ).tile.empty() );
+    // the same tile is interned once
+    memory.memorize_tile( 2, c, "t_floor", 1, 2 );
+    CHECK( &memory.get_tile( a ) == &memory.get_tile( c ) );
+
+    memory.clear_memorized_tile( a );
+    CHECK( memory.get_tile( a ).tile.empty() );
+    CHECK( memory.get_symbol( a ) == 0 );
+    CHECK( memory.get_tile( a2 ).tile == "t_wall" );
+}
+
+TEST_CASE( "map_memory_keeps_chunks_in_region_files", "[map_memory]" )
+{
+    const std::string dir = PATH_INFO::savedir() + "map_memory_test.mmr";
+    const tripoint near_pos( 5, 5, 0 );
+    // a few regions away, so it is unloaded around near_pos
+    const tripoint far_pos( SEEX * 8 * 3 + 1, 2, -1 );
+
+    map_memory memory;
+    memory.memorize_tile( 100, near_pos, "t_dirt", 0, 0 );
+    memory.memorize_symbol( 100, far_pos, 5 );
+    memory.memorize_tile( 100, far_pos, "f_chair", 0, 3 );
+    memory.set_save_path( dir );
+    // nothing is written before saving, the far region is kept as it is not saved yet
+    memory.prepare_region( near_pos );
+    CHECK( get_files_from_path( ".mmr", dir, false, true ).empty() );
+    CHECK( memory.get_symbol( far_pos ) == 5 );
+    REQUIRE( memory.save_regions() );
+    memory.prepare_region( near_pos );
+    // read back from the region file
+    CHECK( memory.get_symbol( far_pos ) == 5 );
+    CHECK( memory.get_tile( far_pos ).tile == "f_chair" );
+    CHECK( memory.get_tile( far_pos ).rotation == 3 );
+
+    // memorizing in an unloaded region keeps what the region already remembered
+    const tripoint far_neighbour = far_pos + point( SEEX, 0 );
+    memory.prepare_region( near_pos );
+    memory.memorize_symbol( 100, far_neighbour, 6 );
+    REQUIRE( memory.save_regions() );
+    memory.prepare_region( near_pos );
+    CHECK( memory.get_symbol( far_pos ) == 5 );
+    CHECK( memory.get_symbol( far_neighbour ) == 6 );
+
+    std::ostringstream jsout_s;
+    JsonOut jsout( jsout_s );
+    memory.store( jsout );
+
+    map_memory memory2;
+    memory2.set_save_path( dir );
+    std::istringstream jsin_s( jsout_s.str() );
+    JsonIn jsin( jsin_s );
+    memory2.load( jsin );
+    CHECK( memory2.get_tile( near_pos ).tile == "t_dirt" );
+    CHECK( memory2.get_symbol( far_pos ) == 5 );
+    CHECK( memory2.get_tile( far_pos ).tile == "f_chair" );
+
+    for( const std::string &file : get_files_from_path( ".mmr", dir, false, true ) ) {
+        remove_file( file );
+    }
+    remove_directory( dir );
+}
+
 #include <chrono>
 
 TEST_CASE( "lru_cache_perf", "[.]" )
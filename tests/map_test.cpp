@@ -5,12 +5,20 @@
 #include <vector>
 
 #include "avatar.h"
+#include "calendar.h"
+#include "coordinate_conversions.h"
 #include "coordinates.h"
 #include "enums.h"
 #include "game.h"
 #include "game_constants.h"
+#include "item.h"
 #include "map_helpers.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
 #include "point.h"
+#include "regional_settings.h"
+#include "rng.h"
+#include "submap.h"
 #include "type_id.h"
 
 TEST_CASE( "destroy_grabbed_furniture" )
@@ -93,3 +101,129 @@ TEST_CASE( "place_player_can_safely_move_multiple_submaps" )
     g->place_player( tripoint_zero );
     CHECK( get_map().check_submap_active_item_consistency().empty() );
 }
+
+TEST_CASE( "map_sees_cache_follows_terrain_changes", "[map][vision]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint from( 60, 60, 0 );
+    const tripoint to( 66, 60, 0 );
+    const tripoint between( 63, 60, 0 );
+    here.build_map_cache( 0 );
+    REQUIRE( here.sees( from, to, 60 ) );
+    // Cached answers must not outlive the terrain they were traced through.
+    here.ter_set( between, ter_id( "t_wall" ) );
+    here.build_map_cache( 0 );
+    CHECK_FALSE( here.sees( from, to, 60 ) );
+    CHECK_FALSE( here.sees( to, from, 60 ) );
+
+    const std::vector<bool> batch = here.sees( from, { to, between, from + tripoint_north }, 60 );
+    CHECK( batch == std::vector<bool> { false, true, true } );
+
+    here.ter_set( between, ter_id( "t_floor" ) );
+    here.build_map_cache( 0 );
+    CHECK( here.sees( from, to, 60 ) );
+}
+
+TEST_CASE( "map_set_ter_furn_rect", "[map]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint origin( 60, 60, 0 );
+    const ter_id t_wall( "t_wall" );
+    const ter_id t_floor( "t_floor" );
+    const furn_id f_chair( "f_chair" );
+
+    here.build_map_cache( 0 );
+    REQUIRE( here.sees( origin + point_south, origin + point( 6, 1 ), 60 ) );
+
+    // A 3 x 2 rectangle: a wall in the middle of the second row, a chair on
+    // floor before it and nothing set after it.
+    std::vector<ter_furn_id> plane( 6 );
+    plane[3].ter = t_floor;
+    plane[3].furn = f_chair;
+    plane[4].ter = t_wall;
+    here.set_ter_furn_rect( origin + point( 2, 0 ), point( 3, 2 ), plane );
+
+    CHECK( here.ter( origin + point( 2, 1 ) ) == t_floor );
+    CHECK( here.furn( origin + point( 2, 1 ) ) == f_chair );
+    CHECK( here.ter( origin + point( 3, 1 ) ) == t_wall );
+    CHECK( here.furn( origin + point( 3, 1 ) ) == f_null );
+    CHECK( here.ter( origin + point( 4, 1 ) ) == ter_id( "t_grass" ) );
+    CHECK( here.ter( origin + point( 3, 0 ) ) == ter_id( "t_grass" ) );
+
+    // The caches must follow the squares set
+    here.build_map_cache( 0 );
+    CHECK_FALSE( here.sees( origin + point_south, origin + point( 6, 1 ), 60 ) );
+}
+
+TEST_CASE( "map_prefetch_generates_submaps_ahead", "[map]" )
+{
+    // In an overmap of its own, so no other test generated it yet
+    const tripoint_abs_omt start_omt( 5 * OMAPX + 90, 5 * OMAPY + 90, 0 );
+    const tripoint start = project_to<coords::sm>( start_omt ).raw();
+    // The first submap the map reaches when moving east
+    const tripoint ahead = start + point( 2, 0 );
+    REQUIRE( MAPBUFFER.lookup_submap( ahead ) == nullptr );
+
+    tinymap tm;
+    tm.load( tripoint_abs_sm( start ), false );
+    tm.prefetch_ahead( point_east );
+    for( int i = 0; i < 100; ++i ) {
+        tm.process_prefetch();
+    }
+
+    submap *prefetched = MAPBUFFER.lookup_submap( ahead );
+    REQUIRE( prefetched != nullptr );
+    // generated, but not touched until the map gets there
+    CHECK( prefetched->last_touched == calendar::before_time_starts );
+
+    tm.load( tripoint_abs_sm( start + point_east * 2 ), false );
+    // the map loaded the prefetched submap instead of generating it again
+    CHECK( MAPBUFFER.lookup_submap( ahead ) == prefetched );
+    CHECK( prefetched->last_touched == calendar::turn );
+}
+
+TEST_CASE( "mapgen_draws_from_its_own_random_stream", "[map]" )
+{
+    // In an overmap of its own, so no other test generated it yet
+    const tripoint_abs_omt omt( 6 * OMAPX + 90, 6 * OMAPY + 90, 0 );
+    const tripoint abs_sub = project_to<coords::sm>( omt ).raw();
+    REQUIRE( MAPBUFFER.lookup_submap( abs_sub ) == nullptr );
+
+    const cata_default_random_engine before = rng_get_engine();
+    tinymap tm;
+    tm.load( tripoint_abs_sm( abs_sub ), false );
+    REQUIRE( MAPBUFFER.lookup_submap( abs_sub ) != nullptr );
+    // Generating the terrain did not draw from the engine of the game
+    CHECK( rng_get_engine() == before );
+}
+
+TEST_CASE( "map_reads_do_not_give_squares_storage", "[map]" )
+{
+    clear_map();
+    map &here = get_map();
+    const map &const_here = here;
+    const tripoint p( 60, 60, 0 );
+    const point l( p.x % SEEX, p.y % SEEY );
+    submap *const sm = MAPBUFFER.lookup_submap( ms_to_sm_copy( here.getabs( p ) ) );
+    REQUIRE( sm != nullptr );
+    sm->release_empty_squares();
+    REQUIRE( sm->get_items_if_any( l ) == nullptr );
+    REQUIRE( sm->get_field_if_any( l ) == nullptr );
+
+    CHECK_FALSE( const_here.has_items( p ) );
+    CHECK( const_here.field_at( p ).field_count() == 0 );
+    CHECK( here.get_field( p, field_type_id( "fd_fire" ) ) == nullptr );
+    CHECK( here.move_cost( p ) > 0 );
+    here.i_clear( p );
+    CHECK( sm->get_items_if_any( l ) == nullptr );
+    CHECK( sm->get_field_if_any( l ) == nullptr );
+
+    // The stack handed out may be changed, so it is the square's own
+    map_stack stack = here.i_at( p );
+    CHECK( sm->get_items_if_any( l ) != nullptr );
+    here.add_item( p, item( "rock" ) );
+    CHECK( stack.size() == 1 );
+    here.i_clear( p );
+}
@@ -0,0 +1,72 @@
+#include "catch/catch.hpp"
+#include "mapbuffer.h"
+
+#include <memory>
+
+#include "coordinate_conversions.h"
+#include "coordinates.h"
+#include "map.h"
+#include "point.h"
+#include "submap.h"
+
+static void add_uniform_quad( mapbuffer &buffer, const tripoint &origin )
+{
+    for( const point &offset : {
+             point_zero, point_south, point_east, point_south_east
+         } ) {
+        std::unique_ptr<submap> sm = std::make_unique<submap>();
+        sm->is_uniform = true;
+        REQUIRE( buffer.add_submap( origin + offset, sm ) );
+    }
+}
+
+TEST_CASE( "mapbuffer_unloads_least_recently_used_quads", "[mapbuffer]" )
+{
+    mapbuffer buffer;
+    // Far from the map, and uniform so nothing is written to disk.
+    const tripoint quad_a( 10000, 10000, 0 );
+    const tripoint quad_b( 10002, 10000, 0 );
+    add_uniform_quad( buffer, quad_a );
+    add_uniform_quad( buffer, quad_b );
+    const size_t quad_memory = 4 * buffer.lookup_submap( quad_a )->memory_usage();
+
+    // Unlimited, or within the budget: nothing changes
+    buffer.unload_cold( 0 );
+    buffer.unload_cold( 2 * quad_memory );
+    CHECK( buffer.lookup_submap( quad_b ) != nullptr );
+    CHECK( buffer.lookup_submap( quad_a ) != nullptr );
+
+    // Quad a was looked up last, quad b goes
+    buffer.unload_cold( quad_memory );
+    CHECK( buffer.lookup_submap( quad_a + point_south_east ) != nullptr );
+    CHECK( buffer.lookup_submap( quad_b ) == nullptr );
+    CHECK( buffer.lookup_submap( quad_b + point_south_east ) == nullptr );
+}
+
+TEST_CASE( "mapbuffer_keeps_quads_recently_in_the_map", "[mapbuffer]" )
+{
+    map &here = get_map();
+    const tripoint map_origin = here.get_abs_sub();
+    mapbuffer buffer;
+    // Added first and never looked up, but inside the map.
+    const tripoint quad_in_map = omt_to_sm_copy( sm_to_omt_copy( map_origin ) );
+    const tripoint quad_a = map_origin + tripoint( 10000, 0, 0 );
+    const tripoint quad_b = map_origin + tripoint( 10002, 0, 0 );
+    add_uniform_quad( buffer, quad_in_map );
+    add_uniform_quad( buffer, quad_a );
+    add_uniform_quad( buffer, quad_b );
+    const size_t quad_memory = 4 * buffer.lookup_submap( quad_a )->memory_usage();
+    REQUIRE( buffer.lookup_submap( quad_b ) != nullptr );
+
+    // Nothing is unloaded, but the quad in the map now counts as used last
+    buffer.unload_cold( 3 * quad_memory );
+
+    // Once the map moves away, the quads looked up before go first
+    here.load( tripoint_abs_sm( map_origin + tripoint( 100, 0, 0 ) ), false );
+    buffer.unload_cold( quad_memory );
+    here.load( tripoint_abs_sm( map_origin ), false );
+    CHECK( buffer.lookup_submap( quad_a ) == nullptr );
+    CHECK( buffer.lookup_submap( quad_b ) == nullptr );
+    CHECK( buffer.lookup_submap( quad_in_map ) != nullptr );
+    CHECK( buffer.lookup_submap( quad_in_map + point_south_east ) != nullptr );
+}
@@ -4,6 +4,7 @@
 #include <utility>
 #include <vector>
 
+#include "avatar.h"
 #include "catch/catch.hpp"
 #include "character.h"
 #include "mutation.h"
@@ -11,6 +12,7 @@
 #include "player.h"
 #include "player_helpers.h"
 #include "type_id.h"
+#include "units.h"
 
 static std::string get_mutations_as_string( const player &p );
 
@@ -258,3 +260,34 @@ TEST_CASE( "Scout and Topographagnosia traits affect overmap sight range", "[mut
         }
     }
 }
+
+TEST_CASE( "character flag index follows traits and bionics", "[mutations][bionics][flags]" )
+{
+    avatar &dummy = get_avatar();
+    clear_avatar();
+    const json_character_flag infrared( "INFRARED" );
+    REQUIRE_FALSE( dummy.has_flag( infrared ) );
+
+    dummy.toggle_trait( trait_id( "INFRARED" ) );
+    CHECK( dummy.has_trait_flag( infrared ) );
+    CHECK( dummy.has_flag( infrared ) );
+    CHECK( dummy.check_flag_index() );
+
+    dummy.toggle_trait( trait_id( "INFRARED" ) );
+    CHECK_FALSE( dummy.has_flag( infrared ) );
+    CHECK( dummy.check_flag_index() );
+
+    // only provided while the bionic is active
+    dummy.set_max_power_level( 100_kJ );
+    dummy.set_power_level( 100_kJ );
+    dummy.add_bionic( bionic_id( "bio_infrared" ) );
+    CHECK_FALSE( dummy.has_bionic_with_flag( infrared ) );
+    CHECK( dummy.check_flag_index() );
+
+    dummy.clear_bionics();
+    CHECK( dummy.check_flag_index() );
+    give_and_activate_bionic( dummy, bionic_id( "bio_infrared" ) );
+    CHECK( dummy.has_bionic_with_flag( infrared ) );
+    CHECK( dummy.has_flag( infrared ) );
+    CHECK( dummy.check_flag_index() );
+}
@@ -20,6 +20,7 @@
 #include "memory_fast.h"
 #include "npc.h"
 #include "npc_class.h"
+#include "npc_perception.h"
 #include "optional.h"
 #include "overmapbuffer.h"
 #include "pimpl.h"
@@ -450,3 +451,26 @@ TEST_CASE( "npc_can_target_player" )
     REQUIRE( hostile.current_target() != nullptr );
     CHECK( hostile.current_target() == static_cast<Creature *>( &player_character ) );
 }
+
+TEST_CASE( "npc_perception_is_shared_within_a_turn", "[npc]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint first_fire( 33, 33, 0 );
+    const tripoint second_fire( 35, 33, 0 );
+    here.add_field( first_fire, fd_fire, 1, 10_minutes );
+
+    npc_perception &perception = get_npc_perception();
+    REQUIRE_FALSE( perception.in_turn() );
+    CHECK( perception.fires( 0 ) == std::vector<tripoint> { first_fire } );
+
+    {
+        npc_perception::turn_scope turn;
+        CHECK( perception.fires( 0 ) == std::vector<tripoint> { first_fire } );
+        // Facts are computed once per turn, so new fires show up next turn.
+        here.add_field( second_fire, fd_fire, 1, 10_minutes );
+        CHECK( perception.fires( 0 ) == std::vector<tripoint> { first_fire } );
+    }
+
+    CHECK( perception.fires( 0 ).size() == 2 );
+}
@@ -66,3 +66,14 @@ TEST_CASE( "om_noise_layer_lake_export", "[.]" )
     export_raw_noise( "lake-map-raw.pgm", f, OMAPX * 5, OMAPY * 5 );
     export_interpreted_noise( "lake-map-interp.pgm", f, OMAPX * 5, OMAPY * 5, 0.25 );
 }
+
+TEST_CASE( "om_noise_grid_matches_layer", "[overmap][noise]" )
+{
+    const om_noise::om_noise_layer_forest f( point_abs_omt( 360, -180 ), 1920237457 );
+    const om_noise::om_noise_grid grid( f );
+    for( int x = -2; x < OMAPX + 2; x++ ) {
+        for( int y = -2; y < OMAPY + 2; y += 7 ) {
+            CHECK( grid.noise_at( { x, y } ) == f.noise_at( { x, y } ) );
+        }
+    }
+}
@@ -1,4 +1,8 @@
+#include <algorithm>
+#include <climits>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "calendar.h"
@@ -8,9 +12,12 @@
 #include "enums.h"
 #include "game_constants.h"
 #include "omdata.h"
+#include "options_helpers.h"
+#include "optional.h"
 #include "overmap.h"
 #include "overmap_types.h"
 #include "overmapbuffer.h"
+#include "string_formatter.h"
 #include "type_id.h"
 
 TEST_CASE( "set_and_get_overmap_scents" )
@@ -176,3 +183,169 @@ TEST_CASE( "is_ot_match", "[overmap][terrain]" )
     }
 }
 
+
+static std::vector<oter_id> overmap_terrain( const overmap &om )
+{
+    std::vector<oter_id> result;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        for( int x = 0; x < OMAPX; ++x ) {
+            for( int y = 0; y < OMAPY; ++y ) {
+                result.push_back( om.ter( { x, y, z } ) );
+            }
+        }
+    }
+    return result;
+}
+
+// Everything generation decides per overmap terrain, as text for readable failures.
+static std::vector<std::string> overmap_contents( const overmap &om )
+{
+    std::vector<std::string> result;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        for( int x = 0; x < OMAPX; ++x ) {
+            for( int y = 0; y < OMAPY; ++y ) {
+                const tripoint_om_omt p( x, y, z );
+                const cata::optional<overmap_special_id> special = om.overmap_special_at( p );
+                result.push_back( string_format( "%s %s %s %s", p.to_string(), om.ter( p ).id().str(),
+                                                 special ? special->str() : "-",
+                                                 om.has_note( p ) ? om.note( p ) : "-" ) );
+            }
+        }
+    }
+    return result;
+}
+
+TEST_CASE( "prefetched_overmap_matches_synchronous_generation", "[overmap][slow]" )
+{
+    const point_abs_om p( 40, -40 );
+    overmap_buffer.clear();
+    overmap_buffer.prefetch( p );
+    const std::vector<std::string> prefetched = overmap_contents( overmap_buffer.get( p ) );
+
+    overmap_buffer.clear();
+    const std::vector<std::string> generated = overmap_contents( overmap_buffer.get( p ) );
+    overmap_buffer.clear();
+
+    REQUIRE( prefetched.size() == generated.size() );
+    for( size_t i = 0; i < prefetched.size(); ++i ) {
+        if( prefetched[i] != generated[i] ) {
+            CHECK( prefetched[i] == generated[i] );
+        }
+    }
+}
+
+TEST_CASE( "overmap_terrain_save_round_trip", "[overmap]" )
+{
+    overmap om( point_abs_om( 100, 100 ) );
+    const oter_id road( "road_ns" );
+    const oter_id forest( "forest" );
+    om.ter_set( { 0, 0, 0 }, road );
+    om.ter_set( { 1, 0, 0 }, road );
+    om.ter_set( { OMAPX - 1, OMAPY - 1, 0 }, forest );
+    om.ter_set( { 5, 7, -1 }, forest );
+
+    SECTION( "runs naming their terrain" ) {
+        std::stringstream saved;
+        om.serialize( saved );
+        CHECK( saved.str().find( "\"terrain_ids\"" ) == std::string::npos );
+        CHECK( saved.str().find( "[\"road_ns\",2]" ) != std::string::npos );
+
+        overmap loaded( point_abs_om( 100, 100 ) );
+        loaded.unserialize( saved );
+        CHECK( overmap_terrain( loaded ) == overmap_terrain( om ) );
+    }
+    SECTION( "runs referring to a table of the terrain used" ) {
+        override_option table( "OVERMAP_TERRAIN_TABLE", "true" );
+        std::stringstream saved;
+        om.serialize( saved );
+        CHECK( saved.str().find( "\"terrain_ids\"" ) != std::string::npos );
+        CHECK( saved.str().find( "[\"road_ns\",2]" ) == std::string::npos );
+
+        overmap loaded( point_abs_om( 100, 100 ) );
+        loaded.unserialize( saved );
+        CHECK( overmap_terrain( loaded ) == overmap_terrain( om ) );
+    }
+}
+
+TEST_CASE( "overmap_terrain_loads_runs_of_ids", "[overmap]" )
+{
+    // Saves from before the terrain table name the terrain of each run
+    std::string layers;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        layers += z == -OVERMAP_DEPTH ? "[" : ",";
+        if( z == 0 ) {
+            layers += string_format( "[[\"road_ns\",2],[\"field\",%d]]", OMAPX * OMAPY - 2 );
+        } else {
+            layers += string_format( "[[\"forest\",%d]]", OMAPX * OMAPY );
+        }
+    }
+    std::istringstream saved( "{\"layers\":" + layers + "]}" );
+    overmap loaded( point_abs_om( 100, 100 ) );
+    loaded.unserialize( saved );
+    CHECK( loaded.ter( { 0, 0, 0 } ) == oter_id( "road_ns" ) );
+    CHECK( loaded.ter( { 1, 0, 0 } ) == oter_id( "road_ns" ) );
+    CHECK( loaded.ter( { 2, 0, 0 } ) == oter_id( "field" ) );
+    CHECK( loaded.ter( { 2, 0, 1 } ) == oter_id( "forest" ) );
+}
+
+TEST_CASE( "overmap_terrain_index_follows_ter_set", "[overmap]" )
+{
+    overmap om( point_abs_om( 100, 100 ) );
+    const oter_id road( "road_ns" );
+    const auto squares_of = [&om]( const oter_id & id, int z ) {
+        std::vector<tripoint_om_omt> result;
+        const om_terrain_index &index = om.terrain_index( z );
+        for( const om_terrain_index::run &r : index.runs ) {
+            for( int i = r.begin; r.id == id && i < r.end; ++i ) {
+                result.emplace_back( index.cell_point( i ), z );
+            }
+        }
+        return result;
+    };
+
+    CHECK( squares_of( road, 0 ).empty() );
+    om.ter_set( { 3, 4, 0 }, road );
+    om.ter_set( { 170, 2, 0 }, road );
+    CHECK( squares_of( road, 0 ) ==
+           std::vector<tripoint_om_omt> { { 170, 2, 0 }, { 3, 4, 0 } } );
+    om.ter_set( { 170, 2, 0 }, oter_id( "field" ) );
+    CHECK( squares_of( road, 0 ) == std::vector<tripoint_om_omt> { { 3, 4, 0 } } );
+    CHECK( squares_of( road, 1 ).empty() );
+}
+
+TEST_CASE( "find_closest_matches_exhaustive_search", "[overmap][slow]" )
+{
+    overmap_buffer.clear();
+    const point_abs_om om_pos( 30, 30 );
+    overmap &om = overmap_buffer.get( om_pos );
+    const tripoint_abs_omt origin = project_combine( om_pos, tripoint_om_omt( 90, 90, 0 ) );
+
+    omt_find_params params;
+    params.types = { { "road", ot_match_type::type } };
+    params.existing_only = true;
+
+    int nearest = INT_MAX;
+    int count = 0;
+    for( int x = 0; x < OMAPX; ++x ) {
+        for( int y = 0; y < OMAPY; ++y ) {
+            const tripoint_om_omt p( x, y, 0 );
+            if( is_ot_match( "road", om.ter( p ), ot_match_type::type ) ) {
+                nearest = std::min( nearest, square_dist( origin, project_combine( om_pos, p ) ) );
+                count++;
+            }
+        }
+    }
+    REQUIRE( count > 0 );
+
+    const tripoint_abs_omt found = overmap_buffer.find_closest( origin, params );
+    CHECK( square_dist( origin, found ) == nearest );
+    CHECK( is_ot_match( "road", overmap_buffer.ter( found ), ot_match_type::type ) );
+
+    // The search does not leave the one existing overmap
+    const std::vector<tripoint_abs_omt> all = overmap_buffer.find_all( origin, params );
+    CHECK( static_cast<int>( all.size() ) == count );
+    for( size_t i = 1; i < all.size(); ++i ) {
+        CHECK( square_dist( origin, all[i - 1] ) <= square_dist( origin, all[i] ) );
+    }
+    overmap_buffer.clear();
+}
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "profiler.h"
+
+static std::vector<profiler::zone_stats>::const_iterator find_zone(
+    const std::vector<profiler::zone_stats> &stats, const std::string &name )
+{
+    return std::find_if( stats.begin(), stats.end(), [&]( const profiler::zone_stats & s ) {
+        return s.name == name;
+    } );
+}
+
+TEST_CASE( "profiler_records_nested_zones", "[profiler]" )
+{
+    profiler::clear();
+    profiler::set_enabled( true );
+    profiler::mark_turn();
+    {
+        profiler::zone outer( "test_outer" );
+        for( int i = 0; i < 3; ++i ) {
+            profiler::zone inner( "test_inner" );
+        }
+    }
+    profiler::set_enabled( false );
+    {
+        profiler::zone ignored( "test_ignored" );
+    }
+
+    const std::vector<profiler::zone_sample> samples = profiler::thread_samples();
+    REQUIRE( samples.size() == 4 );
+    // Zones are recorded on completion, so the inner ones come first.
+    for( int i = 0; i < 3; ++i ) {
+        CHECK( std::string( samples[i].name ) == "test_inner" );
+        CHECK( samples[i].depth == 1 );
+        CHECK( samples[i].start_ns <= samples[i].end_ns );
+    }
+    CHECK( std::string( samples[3].name ) == "test_outer" );
+    CHECK( samples[3].depth == 0 );
+    CHECK( samples[3].start_ns <= samples[0].start_ns );
+    CHECK( samples[3].end_ns >= samples[2].end_ns );
+
+    const std::vector<profiler::zone_stats> stats = profiler::summarize( 1 );
+    REQUIRE( stats.size() == 2 );
+    const auto outer = find_zone( stats, "test_outer" );
+    const auto inner = find_zone( stats, "test_inner" );
+    REQUIRE( outer != stats.end() );
+    REQUIRE( inner != stats.end() );
+    CHECK( outer->calls == 1 );
+    CHECK( inner->calls == 3 );
+    CHECK( outer->total_ns >= inner->total_ns );
+    CHECK( find_zone( stats, "test_ignored" ) == stats.end() );
+
+    profiler::clear();
+    CHECK( profiler::thread_samples().empty() );
+}
+
+TEST_CASE( "profiler_ring_buffer_keeps_latest_zones", "[profiler]" )
+{
+    profiler::clear();
+    for( int i = 0; i < profiler::ring_buffer_size + 10; ++i ) {
+        profiler::record( i < 10 ? "test_old" : "test_new", i, i + 1 );
+    }
+    const std::vector<profiler::zone_sample> samples = profiler::thread_samples();
+    REQUIRE( samples.size() == static_cast<size_t>( profiler::ring_buffer_size ) );
+    CHECK( samples.front().start_ns == 10 );
+    CHECK( samples.back().start_ns == profiler::ring_buffer_size + 9 );
+    const std::vector<profiler::zone_stats> stats = profiler::summarize( 0 );
+    CHECK( find_zone( stats, "test_old" ) == stats.end() );
+    profiler::clear();
+}
+
+TEST_CASE( "profiler_zone_can_end_early", "[profiler]" )
+{
+    profiler::clear();
+    profiler::set_enabled( true );
+    {
+        profiler::zone z( "test_early" );
+        z.end();
+        profiler::zone after( "test_after" );
+    }
+    profiler::set_enabled( false );
+    const std::vector<profiler::zone_sample> samples = profiler::thread_samples();
+    REQUIRE( samples.size() == 2 );
+    CHECK( std::string( samples[0].name ) == "test_early" );
+    CHECK( samples[0].depth == 0 );
+    CHECK( std::string( samples[1].name ) == "test_after" );
+    CHECK( samples[1].depth == 0 );
+    CHECK( samples[0].end_ns <= samples[1].start_ns );
+    profiler::clear();
+}
+
+TEST_CASE( "profiler_reuses_rings_of_exited_threads", "[profiler]" )
+{
+    profiler::clear();
+    std::thread( []() {
+        profiler::record( "test_worker", 1, 2 );
+    } ).join();
+    std::vector<profiler::zone_sample> seen;
+    std::thread( [&]() {
+        seen = profiler::thread_samples();
+    } ).join();
+    // The second thread took over the ring the first one handed back.
+    REQUIRE( seen.size() == 1 );
+    CHECK( std::string( seen[0].name ) == "test_worker" );
+    profiler::clear();
+}
+
+TEST_CASE( "profiler_reads_and_clears_rings_of_recording_threads", "[profiler]" )
+{
+    profiler::clear();
+    std::atomic<bool> done{ false };
+    std::thread worker( [&]() {
+        // Enough to wrap the ring several times
+        for( int i = 0; i < 4 * profiler::ring_buffer_size; ++i ) {
+            profiler::record( "test_busy_worker", i, i + 1 );
+        }
+        done = true;
+    } );
+    while( !done ) {
+        const std::vector<profiler::zone_stats> stats = profiler::summarize( 0 );
+        const auto busy = find_zone( stats, "test_busy_worker" );
+        if( busy != stats.end() ) {
+            CHECK( busy->calls <= profiler::ring_buffer_size );
+            CHECK( busy->total_ns == busy->calls );
+        }
+        profiler::clear();
+    }
+    worker.join();
+    // A clear after the last zone is not undone
+    profiler::clear();
+    const std::vector<profiler::zone_stats> stats = profiler::summarize( 0 );
+    CHECK( find_zone( stats, "test_busy_worker" ) == stats.end() );
+}
@@ -78,3 +78,15 @@ TEST_CASE( "random_entry_preserves_constness" )
     i1 = 5678;
     CHECK( v1[0] == 5678 );
 }
+
+TEST_CASE( "rng_seed_scope_is_reproducible" )
+{
+    const auto rolls = []() {
+        const rng_seed_scope seeded( 1234 );
+        return std::vector<double> { normal_roll( 0, 1 ), normal_roll( 0, 1 ), rng_float( 0, 1 ) };
+    };
+    const std::vector<double> first = rolls();
+    // A normal roll outside the scope leaves the second value of its pair pending
+    normal_roll( 0, 1 );
+    CHECK( rolls() == first );
+}
@@ -1,7 +1,12 @@
 #include "catch/catch.hpp"
 #include "simple_pathfinding.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "coordinates.h"
+#include "game_constants.h"
+#include "line.h"
 #include "point.h"
 
 template<typename Point>
@@ -30,3 +35,56 @@ TEST_CASE( "simple_line_path" )
     test_path<point>();
     test_path<point_abs_omt>();
 }
+
+TEST_CASE( "path_around_wall_repeated_searches" )
+{
+    const point start;
+    const point finish( 4, 0 );
+    const point max( 10, 10 );
+
+    // A wall at x == 2, open only at the bottom row
+    const auto estimate = [&]( const pf::node<point> &cur, const pf::node<point> * ) {
+        if( cur.pos.x == 2 && cur.pos.y < 9 ) {
+            return pf::rejected;
+        }
+        return manhattan_dist( finish, cur.pos );
+    };
+
+    // The search state is reused between searches, the results must not depend on it
+    for( int i = 0; i < 3; ++i ) {
+        const pf::path<point> pth = pf::find_path( start, finish, max, estimate );
+        REQUIRE( pth.nodes.size() >= 2 );
+        CHECK( pth.nodes.front().pos == finish );
+        CHECK( pth.nodes.back().pos == start );
+        for( size_t n = 1; n < pth.nodes.size(); ++n ) {
+            CHECK( manhattan_dist( pth.nodes[n - 1].pos, pth.nodes[n].pos ) == 1 );
+            CHECK( estimate( pth.nodes[n], nullptr ) != pf::rejected );
+        }
+        CHECK( std::any_of( pth.nodes.begin(), pth.nodes.end(), []( const pf::node<point> &n ) {
+            return n.pos == point( 2, 9 );
+        } ) );
+        // A search over a different area in between
+        CHECK( pf::find_path( start, point( 3, 0 ), point( 5, 5 ), estimate ).nodes.empty() );
+    }
+}
+
+TEST_CASE( "path_search_keeps_scratch" )
+{
+    const auto estimate = []( const pf::node<point> &, const pf::node<point> * ) {
+        return 1;
+    };
+    const std::vector<pf::search_cell> &cells = pf::get_search_scratch().cells;
+
+    // The squares of a search as large as those of NPC travel are kept for the next one
+    const point max( OMAPX * 8, OMAPY * 8 );
+    REQUIRE( pf::find_path( point_zero, point( 3, 0 ), max, estimate ).nodes.size() == 4 );
+    REQUIRE( cells.size() == static_cast<size_t>( max.x ) * max.y );
+    const pf::search_cell *const data = cells.data();
+    REQUIRE_FALSE( pf::find_path( point_zero, point( 0, 3 ), max, estimate ).nodes.empty() );
+    CHECK( cells.data() == data );
+
+    // Until the thread releases them
+    pf::get_search_scratch().release();
+    CHECK( cells.empty() );
+    CHECK( cells.capacity() == 0 );
+}
@@ -160,6 +160,32 @@ TEST_CASE( "stats_tracker_event_time_bounds", "[stats]" )
     CHECK( s.get_events( ctd ).last()->second.last == calendar::turn );
 }
 
+TEST_CASE( "event_multiset_merges_events_by_their_values", "[stats]" )
+{
+    const character_id u_id = get_player_character().getID();
+    constexpr event_type ctd = event_type::character_takes_damage;
+    event_multiset events( ctd );
+
+    events.add( cata::event::make<ctd>( u_id, 10 ) );
+    events.add( cata::event::make<ctd>( u_id, 10 ) );
+    // Read in between, the next events are summed into the same summary
+    CHECK( events.counts().size() == 1 );
+    events.add( cata::event::make<ctd>( u_id, 10 ) );
+    events.add( cata::event::make<ctd>( u_id, 5 ) );
+    // Events not made by event::make are summarized by their fields all the same
+    cata::event::data_type data{ { "character", cata_variant( u_id ) },
+        { "damage", cata_variant( 10 ) } };
+    events.add( cata::event( ctd, calendar::turn, std::move( data ) ) );
+
+    CHECK( events.count() == 5 );
+    const event_multiset::summaries_type &counts = events.counts();
+    REQUIRE( counts.size() == 2 );
+    const cata::event::data_type damage_10{ { "character", cata_variant( u_id ) },
+        { "damage", cata_variant( 10 ) } };
+    CHECK( counts.at( damage_10 ).count == 4 );
+    CHECK( events.total( "damage" ) == 45 );
+}
+
 static void send_game_start( event_bus &b, const character_id &u_id )
 {
     b.send<event_type::game_start>(
@@ -542,6 +568,44 @@ TEST_CASE( "stats_tracker_watchers", "[stats]" )
     }
 }
 
+TEST_CASE( "stats_tracker_watched_values", "[stats]" )
+{
+    stats_tracker s;
+    event_bus b;
+    b.subscribe( &s );
+
+    const mtype_id no_monster;
+    const ter_id t_null( "t_null" );
+    const cata::event walk = cata::event::make<event_type::avatar_moves>( no_monster, t_null,
+                             move_mode_walk, false, 0 );
+    const cata::event run = cata::event::make<event_type::avatar_moves>( no_monster, t_null,
+                            move_mode_run, false, 0 );
+
+    const string_id<event_statistic> stat_moves( "num_moves" );
+    const string_id<event_statistic> stat_walked( "num_moves_walked" );
+    const string_id<event_transformation> moves_walked( "moves_walked" );
+
+    b.send( walk );
+    b.send( run );
+
+    // Statistics which nothing watches are computed from the events, the
+    // watched ones are kept by their state; both must give the same answers
+    CHECK( s.value_of( stat_moves ) == cata_variant( 2 ) );
+    CHECK( s.value_of( stat_walked ) == cata_variant( 1 ) );
+    CHECK( s.get_events( moves_walked ).count() == 1 );
+
+    watch_stat moves_watcher;
+    watch_stat walked_watcher;
+    s.add_watcher( stat_moves, &moves_watcher );
+    s.add_watcher( stat_walked, &walked_watcher );
+
+    b.send( walk );
+    CHECK( s.value_of( stat_moves ) == cata_variant( 3 ) );
+    CHECK( s.value_of( stat_walked ) == cata_variant( 2 ) );
+    CHECK( s.get_events( moves_walked ).count() == 2 );
+    CHECK( s.get_events( event_type::avatar_moves ).count() == 3 );
+}
+
 TEST_CASE( "achievements_tracker", "[stats]" )
 {
     override_option opt( "24_HOUR", "military" );
@@ -1,7 +1,10 @@
 #include "catch/catch.hpp"
 #include "submap.h"
 
+#include "calendar.h"
+#include "colony.h"
 #include "game_constants.h"
+#include "item.h"
 #include "point.h"
 #include "type_id.h"
 
@@ -115,3 +118,36 @@ TEST_CASE( "submap rotation2", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap_sparse_items", "[submap]" )
+{
+    submap sm;
+    const point with_items( 2, 3 );
+    const point looked_at( 5, 5 );
+    const point other( 7, 1 );
+
+    const submap &csm = sm;
+    CHECK( csm.get_items( with_items ).empty() );
+
+    sm.get_items( with_items ).insert( item( "rock", calendar::turn_zero ) );
+    sm.get_items( with_items ).insert( item( "rock", calendar::turn_zero ) );
+    CHECK( sm.get_items( looked_at ).empty() );
+    sm.get_items( other ).insert( item( "steel_chunk", calendar::turn_zero ) );
+    const cata::colony<item> *other_items = &sm.get_items( other );
+
+    // Reading a square never gives it the items of another one
+    CHECK( csm.get_items( with_items ).size() == 2 );
+    CHECK( csm.get_items( looked_at ).empty() );
+    CHECK( csm.get_items( other ).size() == 1 );
+
+    sm.release_empty_squares();
+    CHECK( csm.get_items( with_items ).size() == 2 );
+    CHECK( csm.get_items( looked_at ).empty() );
+    CHECK( csm.get_items( other ).size() == 1 );
+    CHECK( &sm.get_items( other ) == other_items );
+
+    sm.rotate( 1 );
+    CHECK( csm.get_items( with_items.rotate( 1, { SEEX, SEEY } ) ).size() == 2 );
+    CHECK( csm.get_items( other.rotate( 1, { SEEX, SEEY } ) ).size() == 1 );
+    CHECK( csm.get_items( with_items ).empty() );
+}